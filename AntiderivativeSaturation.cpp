@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    AntiderivativeSaturation.cpp
+    Created: 17 Oct 2026 6:05:18pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "AntiderivativeSaturation.h"
+
+namespace
+{
+    constexpr double ln2 = 0.69314718055994530942;
+
+    // Li2 (-t) for 0 <= t <= 1, from the Bernoulli series in u = -log (1 + t).
+    // |u| <= log 2 here, so seven terms are good to about 1e-15.
+    double negativeDilogarithm (double t) noexcept
+    {
+        const auto u = -std::log1p (t);
+        const auto u2 = u * u;
+
+        return u * (1.0 + u * (-1.0 / 4.0 + u * (1.0 / 36.0
+                  + u2 * (-1.0 / 3600.0 + u2 * (1.0 / 211680.0 + u2 * (-1.0 / 10886400.0
+                  + u2 * (1.0 / 526901760.0 + u2 * (-691.0 / 16999766784000.0))))))));
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+double AntiderivativeSaturation<SampleType>::logCosh (double x) noexcept
+{
+    // Rearranged so cosh never overflows
+    const auto magnitude = std::abs (x);
+    return magnitude + std::log1p (std::exp (-2.0 * magnitude)) - ln2;
+}
+
+template <typename SampleType>
+double AntiderivativeSaturation<SampleType>::logCoshIntegral (double x) noexcept
+{
+    const auto magnitude = std::abs (x);
+    const auto integral = magnitude * (0.5 * magnitude - ln2)
+                        + 0.5 * negativeDilogarithm (std::exp (-2.0 * magnitude))
+                        + juce::MathConstants<double>::pi * juce::MathConstants<double>::pi / 24.0;
+
+    return x < 0.0 ? -integral : integral;
+}
+
+//==============================================================================
+template <typename SampleType>
+void AntiderivativeSaturation<SampleType>::prepare (int numChannels)
+{
+    state.assign ((size_t) numChannels, {});
+}
+
+template <typename SampleType>
+void AntiderivativeSaturation<SampleType>::reset() noexcept
+{
+    std::fill (state.begin(), state.end(), ChannelState());
+}
+
+template <typename SampleType>
+void AntiderivativeSaturation<SampleType>::setOrder (Order newOrder) noexcept
+{
+    if (order == newOrder)
+        return;
+
+    order = newOrder;
+
+    // The history is valid for either order, but the cached antiderivatives
+    // are only kept up to date by the order that was running
+    for (auto& s : state)
+    {
+        s.f1 = logCosh (s.x1);
+        s.f2 = logCoshIntegral (s.x1);
+        s.d1 = std::abs (s.x1 - s.x2) < tolerance ? logCosh (0.5 * (s.x1 + s.x2))
+                                                  : (s.f2 - logCoshIntegral (s.x2)) / (s.x1 - s.x2);
+    }
+}
+
+template <typename SampleType>
+void AntiderivativeSaturation<SampleType>::process (int channel, const SampleType* input, SampleType* output,
+                                                    int numSamples, SampleType drive) noexcept
+{
+    jassert (juce::isPositiveAndBelow (channel, (int) state.size()));
+    auto& s = state[(size_t) channel];
+
+    if (order == Order::second)
+        processSecondOrder (s, input, output, numSamples, (double) drive);
+    else
+        processFirstOrder (s, input, output, numSamples, (double) drive);
+}
+
+template <typename SampleType>
+void AntiderivativeSaturation<SampleType>::processFirstOrder (ChannelState& s, const SampleType* input, SampleType* output,
+                                                              int numSamples, double drive) noexcept
+{
+    auto x1 = s.x1, x2 = s.x2, f1 = s.f1;
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const auto x0 = drive * (double) input[sample];
+        const auto f0 = logCosh (x0);
+        const auto delta = x0 - x1;
+
+        output[sample] = (SampleType) (std::abs (delta) < tolerance ? std::tanh (0.5 * (x0 + x1))
+                                                                    : (f0 - f1) / delta);
+        x2 = x1;
+        x1 = x0;
+        f1 = f0;
+    }
+
+    s.x1 = x1;
+    s.x2 = x2;
+    s.f1 = f1;
+}
+
+template <typename SampleType>
+void AntiderivativeSaturation<SampleType>::processSecondOrder (ChannelState& s, const SampleType* input, SampleType* output,
+                                                               int numSamples, double drive) noexcept
+{
+    auto x1 = s.x1, x2 = s.x2, f2 = s.f2, d1 = s.d1;
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const auto x0 = drive * (double) input[sample];
+        const auto f0 = logCoshIntegral (x0);
+        const auto d0 = std::abs (x0 - x1) < tolerance ? logCosh (0.5 * (x0 + x1)) : (f0 - f2) / (x0 - x1);
+        const auto delta = x0 - x2;
+
+        double y;
+
+        if (std::abs (delta) >= tolerance)
+        {
+            y = 2.0 * (d0 - d1) / delta;
+        }
+        else
+        {
+            // x0 and x2 nearly coincide: average around their midpoint and x1 instead
+            const auto midpoint = 0.5 * (x0 + x2);
+            const auto spread = midpoint - x1;
+
+            y = std::abs (spread) < tolerance ? std::tanh (0.5 * (midpoint + x1))
+                                              : 2.0 / spread * (logCosh (midpoint) + (f2 - logCoshIntegral (midpoint)) / spread);
+        }
+
+        output[sample] = (SampleType) y;
+        x2 = x1;
+        x1 = x0;
+        f2 = f0;
+        d1 = d0;
+    }
+
+    s.x1 = x1;
+    s.x2 = x2;
+    s.f2 = f2;
+    s.d1 = d1;
+}
+
+//==============================================================================
+template class AntiderivativeSaturation<float>;
+template class AntiderivativeSaturation<double>;
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    AudioTelemetry.h
+    Created: 17 Oct 2026 7:52:10pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/** Peak and RMS of one block, as linear gain. */
+struct LevelReading
+{
+    float peak = 0.0f;
+    float rms = 0.0f;
+};
+
+/** What the audio thread reports after each block. */
+struct BlockTelemetry
+{
+    LevelReading input, drive, output;  // Before the drive stage, straight after it, and at the output
+    float load = 0.0f;                  // processBlock time as a fraction of the block's duration
+    int numSamples = 0;
+};
+
+//==============================================================================
+/** Accumulates peak and RMS over a block in the middle of the DSP. */
+template <typename SampleType>
+struct LevelMeter
+{
+    void reset() noexcept
+    {
+        peak = 0;
+        sumOfSquares = 0.0;
+        numSamples = 0;
+    }
+
+    void add (const SampleType* data, int num) noexcept
+    {
+        auto blockPeak = peak;
+        auto blockSum = (SampleType) 0;
+
+        for (int i = 0; i < num; ++i)
+        {
+            blockPeak = juce::jmax (blockPeak, std::abs (data[i]));
+            blockSum += data[i] * data[i];
+        }
+
+        peak = blockPeak;
+        sumOfSquares += (double) blockSum;
+        numSamples += num;
+    }
+
+    LevelReading getReading() const noexcept
+    {
+        return { (float) peak, numSamples > 0 ? (float) std::sqrt (sumOfSquares / numSamples) : 0.0f };
+    }
+
+    SampleType peak = 0;
+    double sumOfSquares = 0.0;
+    int numSamples = 0;
+};
+
+//==============================================================================
+/** Single-producer, single-consumer queue from the audio thread to the editor.
+
+    Pushing is wait-free and never allocates; if the editor falls behind (or
+    isn't draining at all) new entries are dropped rather than blocking.
+*/
+class TelemetryQueue
+{
+public:
+    /** Audio thread only. Returns false if the queue was full. */
+    bool push (const BlockTelemetry& telemetry) noexcept
+    {
+        const auto scope = fifo.write (1);
+
+        if (scope.blockSize1 > 0)
+            entries[(size_t) scope.startIndex1] = telemetry;
+
+        return scope.blockSize1 > 0;
+    }
+
+    /** Consumer thread only. Calls callback for every queued entry, oldest first,
+        and returns how many there were.
+    */
+    template <typename Callback>
+    int drain (Callback&& callback)
+    {
+        const auto scope = fifo.read (fifo.getNumReady());
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            callback (entries[(size_t) (scope.startIndex1 + i)]);
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            callback (entries[(size_t) (scope.startIndex2 + i)]);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+private:
+    // About half a second of 256-sample blocks at 96 kHz
+    static constexpr int capacity = 256;
+
+    juce::AbstractFifo fifo { capacity };
+    std::array<BlockTelemetry, capacity> entries;
+};
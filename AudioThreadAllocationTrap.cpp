@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    AudioThreadAllocationTrap.cpp
+    Created: 17 Oct 2026 9:12:04am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "AudioThreadAllocationTrap.h"
+
+#if OVERDRIVE_ALLOCATION_TRAP
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined (__GNUC__)
+ #define OVERDRIVE_TRAP_TLS __attribute__ ((tls_model ("initial-exec"))) thread_local
+#else
+ #define OVERDRIVE_TRAP_TLS thread_local
+#endif
+
+namespace
+{
+    // Plain ints only: anything with a constructor could itself allocate.
+    OVERDRIVE_TRAP_TLS int trapDepth = 0;
+
+    void checkAllocation (const char* what) noexcept
+    {
+        if (trapDepth > 0)
+        {
+            trapDepth = 0; // Disarm so the report can't trip the trap again
+            std::fputs ("OverDrive: ", stderr);
+            std::fputs (what, stderr);
+            std::fputs (" called on the audio thread inside processBlock\n", stderr);
+            std::fflush (stderr);
+            std::abort();
+        }
+    }
+}
+
+ScopedAudioThreadAllocationTrap::ScopedAudioThreadAllocationTrap() noexcept   { ++trapDepth; }
+ScopedAudioThreadAllocationTrap::~ScopedAudioThreadAllocationTrap() noexcept  { if (trapDepth > 0) --trapDepth; }
+
+//==============================================================================
+#if defined (__GLIBC__)
+// glibc exports its allocator under these names, so the public symbols can be
+// wrapped without dlsym (which would allocate on first use).
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void* __libc_memalign (size_t, size_t);
+    void  __libc_free (void*);
+
+    void* malloc (size_t size)                 { checkAllocation ("malloc");  return __libc_malloc (size); }
+    void* calloc (size_t num, size_t size)     { checkAllocation ("calloc");  return __libc_calloc (num, size); }
+    void* realloc (void* ptr, size_t size)     { checkAllocation ("realloc"); return __libc_realloc (ptr, size); }
+    void* aligned_alloc (size_t align, size_t size)  { checkAllocation ("aligned_alloc"); return __libc_memalign (align, size); }
+    void* memalign (size_t align, size_t size)       { checkAllocation ("memalign");      return __libc_memalign (align, size); }
+
+    int posix_memalign (void** result, size_t align, size_t size)
+    {
+        checkAllocation ("posix_memalign");
+        *result = __libc_memalign (align, size);
+        return *result != nullptr ? 0 : 12 /* ENOMEM */;
+    }
+
+    void free (void* ptr)
+    {
+        if (ptr != nullptr)
+            checkAllocation ("free");
+
+        __libc_free (ptr);
+    }
+}
+#endif
+
+//==============================================================================
+namespace
+{
+    void* trappedNew (std::size_t size, const char* what)
+    {
+        checkAllocation (what);
+
+        if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+
+    void trappedDelete (void* ptr, const char* what) noexcept
+    {
+        if (ptr != nullptr)
+            checkAllocation (what);
+
+        std::free (ptr);
+    }
+}
+
+void* operator new (std::size_t size)                                 { return trappedNew (size, "operator new"); }
+void* operator new[] (std::size_t size)                               { return trappedNew (size, "operator new[]"); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    checkAllocation ("operator new");
+    return std::malloc (size == 0 ? 1 : size);
+}
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    checkAllocation ("operator new[]");
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+void operator delete (void* ptr) noexcept                             { trappedDelete (ptr, "operator delete"); }
+void operator delete[] (void* ptr) noexcept                           { trappedDelete (ptr, "operator delete[]"); }
+void operator delete (void* ptr, std::size_t) noexcept                { trappedDelete (ptr, "operator delete"); }
+void operator delete[] (void* ptr, std::size_t) noexcept              { trappedDelete (ptr, "operator delete[]"); }
+void operator delete (void* ptr, const std::nothrow_t&) noexcept      { trappedDelete (ptr, "operator delete"); }
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept    { trappedDelete (ptr, "operator delete[]"); }
+
+#endif
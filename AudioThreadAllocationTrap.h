@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    AudioThreadAllocationTrap.h
+    Created: 17 Oct 2026 9:12:04am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*  Debug/test mode that proves the DSP path never touches the heap.
+
+    Build with OVERDRIVE_ALLOCATION_TRAP=1 and the global operator new/delete
+    (and, on glibc, malloc/calloc/realloc/free) are replaced by versions that
+    check a per-thread flag. While a ScopedAudioThreadAllocationTrap is alive on
+    a thread, any allocation or free on that thread prints what happened to
+    stderr and aborts the process.
+
+    The replacements only take effect in an executable (the Standalone plugin,
+    a test host or a batch tool). A plugin binary loaded by a DAW keeps using the
+    host's allocator, so the trap is silent there. With the flag off, which is
+    the default, the scope is an empty object and costs nothing.
+*/
+#ifndef OVERDRIVE_ALLOCATION_TRAP
+ #define OVERDRIVE_ALLOCATION_TRAP 0
+#endif
+
+class ScopedAudioThreadAllocationTrap
+{
+public:
+   #if OVERDRIVE_ALLOCATION_TRAP
+    ScopedAudioThreadAllocationTrap() noexcept;
+    ~ScopedAudioThreadAllocationTrap() noexcept;
+   #else
+    ScopedAudioThreadAllocationTrap() noexcept {}
+    ~ScopedAudioThreadAllocationTrap() noexcept {}
+   #endif
+
+    /** True if this build replaces the allocation functions. */
+    static constexpr bool isCompiledIn() noexcept { return OVERDRIVE_ALLOCATION_TRAP != 0; }
+
+private:
+    ScopedAudioThreadAllocationTrap (const ScopedAudioThreadAllocationTrap&) = delete;
+    ScopedAudioThreadAllocationTrap& operator= (const ScopedAudioThreadAllocationTrap&) = delete;
+};
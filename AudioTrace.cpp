@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    AudioTrace.cpp
+    Created: 18 Oct 2026 2:26:51am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "AudioTrace.h"
+
+#if OVERDRIVE_TRACE
+
+namespace
+{
+    constexpr int flushIntervalMilliseconds = 100;
+
+    // Everything is one process; the tracks (tids) are the instances
+    constexpr int processID = 1;
+
+    juce::File chooseTraceFile()
+    {
+        const auto path = juce::SystemStats::getEnvironmentVariable ("OVERDRIVE_TRACE_FILE", {});
+
+        if (path.isNotEmpty())
+            return juce::File (path);
+
+        return juce::File::getSpecialLocation (juce::File::tempDirectory)
+                   .getChildFile ("OverDriveTrace-" + juce::Time::getCurrentTime().formatted ("%Y%m%d-%H%M%S") + ".json");
+    }
+
+    // Long enough for a first estimate of the timestamp counter's rate; it's refined at every flush
+    constexpr int calibrationMilliseconds = 20;
+}
+
+thread_local TraceBuffer* TraceBuffer::current = nullptr;
+
+//==============================================================================
+TraceBuffer::TraceBuffer()
+    : events ((size_t) capacity)
+{
+    trackID = writer->addBuffer (*this);
+}
+
+TraceBuffer::~TraceBuffer()
+{
+    writer->removeBuffer (*this);
+}
+
+//==============================================================================
+TraceFileWriter::TraceFileWriter()
+    : juce::Thread ("OverDrive Trace"),
+      file (chooseTraceFile())
+{
+    startClock = TraceClock::now();
+    startSystemTicks = juce::Time::getHighResolutionTicks();
+    juce::Thread::sleep (calibrationMilliseconds);
+    calibrate();
+
+    file.deleteFile();
+    stream = file.createOutputStream();
+
+    if (stream == nullptr || ! stream->openedOk())
+    {
+        juce::Logger::writeToLog ("OverDrive: can't write the trace to " + file.getFullPathName());
+        stream.reset();
+        return;
+    }
+
+    juce::Logger::writeToLog ("OverDrive: writing the trace to " + file.getFullPathName());
+
+    // The JSON array form of the trace format; chrome://tracing and Perfetto also read it unterminated, after a crash
+    *stream << "[\n";
+    writeEvent ("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + juce::String (processID) + ",\"args\":{\"name\":\"OverDrive\"}}");
+    startThread();
+}
+
+TraceFileWriter::~TraceFileWriter()
+{
+    stopThread (1000);
+
+    const juce::ScopedLock sl (lock);
+    drainAll();
+
+    if (stream != nullptr)
+    {
+        *stream << "\n]\n";
+        stream->flush();
+    }
+}
+
+int TraceFileWriter::addBuffer (TraceBuffer& buffer)
+{
+    const juce::ScopedLock sl (lock);
+    buffers.add (&buffer);
+
+    const auto trackID = nextTrackID++;
+    writeEvent ("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + juce::String (processID) + ",\"tid\":" + juce::String (trackID)
+                  + ",\"args\":{\"name\":\"OverDrive #" + juce::String (trackID) + "\"}}");
+    return trackID;
+}
+
+void TraceFileWriter::removeBuffer (TraceBuffer& buffer)
+{
+    // Whatever the instance recorded last still makes it into the file
+    const juce::ScopedLock sl (lock);
+    drain (buffer);
+    buffers.removeFirstMatchingValue (&buffer);
+
+    if (const auto numDropped = buffer.getNumDropped(); numDropped > 0)
+        juce::Logger::writeToLog ("OverDrive: the trace of instance #" + juce::String (buffer.getTrackID()) + " dropped " + juce::String (numDropped) + " spans");
+}
+
+void TraceFileWriter::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (flushIntervalMilliseconds);
+
+        const juce::ScopedLock sl (lock);
+        calibrate();
+        drainAll();
+
+        if (stream != nullptr)
+            stream->flush();
+    }
+}
+
+void TraceFileWriter::calibrate()
+{
+    const auto elapsedClock = TraceClock::now() - startClock;
+    const auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startSystemTicks);
+
+    if (elapsedClock > 0)
+        secondsPerClockTick = elapsedSeconds / (double) elapsedClock;
+}
+
+juce::String TraceFileWriter::toMicroseconds (double clockTicks) const
+{
+    return juce::String (clockTicks * secondsPerClockTick * 1.0e6, 3);
+}
+
+void TraceFileWriter::drainAll()
+{
+    for (auto* buffer : buffers)
+        drain (*buffer);
+}
+
+void TraceFileWriter::drain (TraceBuffer& buffer)
+{
+    const auto tid = juce::String (buffer.getTrackID());
+
+    buffer.drain ([&] (const TraceEvent& event)
+    {
+        // A complete event ("X"): start and duration in microseconds
+        writeEvent ("{\"name\":\"" + juce::String (event.name) + "\",\"cat\":\"overdrive\",\"ph\":\"X\",\"pid\":" + juce::String (processID)
+                      + ",\"tid\":" + tid + ",\"ts\":" + toMicroseconds ((double) (event.startTicks - startClock))
+                      + ",\"dur\":" + toMicroseconds ((double) (event.endTicks - event.startTicks)) + "}");
+    });
+}
+
+void TraceFileWriter::writeEvent (const juce::String& json)
+{
+    if (stream == nullptr)
+        return;
+
+    if (! isFirstEvent)
+        *stream << ",\n";
+
+    *stream << json;
+    isFirstEvent = false;
+}
+
+#endif
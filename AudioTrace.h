@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    AudioTrace.h
+    Created: 18 Oct 2026 2:26:51am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/*  Profiling mode that records how long each instance spends in prepareToPlay,
+    each processBlock and each DSP stage, and writes it to a trace file that
+    chrome://tracing and ui.perfetto.dev open directly.
+
+    Build with OVERDRIVE_TRACE=1. Every instance then gets a preallocated
+    single-producer, single-consumer buffer of spans. The audio thread only
+    reads the CPU's timestamp counter twice per span and pushes a fixed-size
+    entry, dropping it if the buffer is full. One background thread, shared by every instance,
+    drains the buffers ten times a second and appends the spans to the file:
+    $OVERDRIVE_TRACE_FILE if that is set, otherwise OverDriveTrace-<time>.json
+    in the temp folder. Each instance is its own track, named after the
+    order it was created in.
+
+    With the flag off, which is the default, OVERDRIVE_TRACE_SPAN expands to
+    nothing and none of this is compiled.
+*/
+#ifndef OVERDRIVE_TRACE
+ #define OVERDRIVE_TRACE 0
+#endif
+
+#if OVERDRIVE_TRACE
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+/** Span timestamps. On Intel/AMD this is the timestamp counter, a fraction of
+    the cost of asking the OS for the time; the writer converts it to the
+    system clock. Elsewhere it is the system clock.
+*/
+struct TraceClock
+{
+    static juce::int64 now() noexcept
+    {
+       #if JUCE_INTEL
+        return (juce::int64) __rdtsc();
+       #else
+        return juce::Time::getHighResolutionTicks();
+       #endif
+    }
+};
+
+/** One finished span, in TraceClock ticks. The name has to be a string literal, or otherwise outlive the trace. */
+struct TraceEvent
+{
+    const char* name = nullptr;
+    juce::int64 startTicks = 0;
+    juce::int64 endTicks = 0;
+};
+
+class TraceFileWriter;
+
+//==============================================================================
+/** The spans of one instance, on their way to the file.
+
+    The producer is the audio thread, plus prepareToPlay, which hosts never
+    call while it is processing. The consumer is the shared writer thread.
+*/
+class TraceBuffer
+{
+public:
+    TraceBuffer();
+    ~TraceBuffer();
+
+    /** Never blocks or allocates. Drops the span if the writer has fallen behind. */
+    void add (const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept
+    {
+        const auto scope = fifo.write (1);
+
+        if (scope.blockSize1 > 0)
+            events[(size_t) scope.startIndex1] = { name, startTicks, endTicks };
+        else
+            numDropped.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    /** Writer thread only. Calls callback for every queued span, oldest first. */
+    template <typename Callback>
+    void drain (Callback&& callback)
+    {
+        const auto scope = fifo.read (fifo.getNumReady());
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            callback (events[(size_t) (scope.startIndex1 + i)]);
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            callback (events[(size_t) (scope.startIndex2 + i)]);
+    }
+
+    int getTrackID() const noexcept                 { return trackID; }
+    juce::uint64 getNumDropped() const noexcept     { return numDropped.load(); }
+
+private:
+    friend class ScopedTraceSpan;
+
+    // Two flushes' worth of 32-sample blocks at 192 kHz, at the ten or so spans a block makes
+    static constexpr int capacity = 16384;
+
+    juce::SharedResourcePointer<TraceFileWriter> writer;
+    juce::AbstractFifo fifo { capacity };
+    std::vector<TraceEvent> events;
+    std::atomic<juce::uint64> numDropped { 0 };
+    int trackID = 0;
+
+    static thread_local TraceBuffer* current;
+
+    JUCE_DECLARE_NON_COPYABLE (TraceBuffer)
+};
+
+//==============================================================================
+/** Times its own lifetime. Given a buffer, it also becomes the current one on
+    this thread until the span ends, so the spans nested inside it (the DSP
+    stages) land in the same instance's track without being handed it.
+*/
+class ScopedTraceSpan
+{
+public:
+    explicit ScopedTraceSpan (const char* spanName) noexcept
+        : ScopedTraceSpan (TraceBuffer::current, spanName) {}
+
+    ScopedTraceSpan (TraceBuffer& buffer, const char* spanName) noexcept
+        : ScopedTraceSpan (&buffer, spanName) {}
+
+    ~ScopedTraceSpan() noexcept
+    {
+        if (buffer != nullptr)
+            buffer->add (name, startTicks, TraceClock::now());
+
+        TraceBuffer::current = previous;
+    }
+
+private:
+    ScopedTraceSpan (TraceBuffer* bufferToUse, const char* spanName) noexcept
+        : buffer (bufferToUse), previous (TraceBuffer::current), name (spanName),
+          startTicks (bufferToUse != nullptr ? TraceClock::now() : 0)
+    {
+        TraceBuffer::current = buffer;
+    }
+
+    TraceBuffer* buffer;
+    TraceBuffer* previous;
+    const char* name;
+    juce::int64 startTicks;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedTraceSpan)
+};
+
+//==============================================================================
+/** Drains every instance's buffer into the trace file on a background thread.
+    Shared by all instances through juce::SharedResourcePointer; the file is
+    opened with the first one and closed, as a complete JSON array, with the last.
+*/
+class TraceFileWriter : private juce::Thread
+{
+public:
+    TraceFileWriter();
+    ~TraceFileWriter() override;
+
+    const juce::File& getFile() const noexcept      { return file; }
+
+private:
+    friend class TraceBuffer;
+
+    int addBuffer (TraceBuffer& buffer);
+    void removeBuffer (TraceBuffer& buffer);
+
+    void run() override;
+
+    // All called with lock held
+    void calibrate();
+    void drainAll();
+    void drain (TraceBuffer& buffer);
+    juce::String toMicroseconds (double clockTicks) const;
+
+    void writeEvent (const juce::String& json);
+
+    juce::CriticalSection lock;
+    juce::Array<TraceBuffer*> buffers;
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    int nextTrackID = 1;
+    bool isFirstEvent = true;
+
+    // TraceClock ticks to seconds on the system clock, measured from when the writer started
+    juce::int64 startClock = 0, startSystemTicks = 0;
+    double secondsPerClockTick = 0.0;
+};
+
+ #define OVERDRIVE_TRACE_SPAN(...)  ScopedTraceSpan JUCE_JOIN_MACRO (traceSpan, __LINE__) (__VA_ARGS__)
+#else
+ #define OVERDRIVE_TRACE_SPAN(...)
+#endif
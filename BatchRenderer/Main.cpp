@@ -0,0 +1,359 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 3:21:36pm
+    Author:  Bradley Smith
+
+    Headless batch renderer. Runs OverDrive4AudioProcessor over WAV/AIFF files
+    without a host or an editor, spreading the files across a pool of workers
+    with one processor instance each.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+namespace
+{
+    struct RenderSettings
+    {
+        juce::File outputDirectory;
+        std::vector<std::pair<juce::String, float>> parameterValues; // Parameter ID and plain (unnormalised) value
+        int blockSize = 1024;
+    };
+
+    struct RenderResult
+    {
+        bool succeeded = false;
+        juce::String message;
+        double audioSeconds = 0.0;
+        double renderSeconds = 0.0;
+        juce::uint64 skippedBlocks = 0;     // Silent blocks the processor didn't need to process
+    };
+
+    //==============================================================================
+    void applyParameters (OverDrive4AudioProcessor& processor, const RenderSettings& settings)
+    {
+        for (const auto& [parameterID, value] : settings.parameterValues)
+            if (auto* parameter = processor.parameters.getParameter (parameterID))
+                parameter->setValueNotifyingHost (parameter->convertTo0to1 (value));
+    }
+
+    /** Reads "PARAMETER_ID=value" lines. Blank lines and lines starting with # are ignored. */
+    bool loadPresetFile (const juce::File& file, RenderSettings& settings, juce::String& error)
+    {
+        if (! file.existsAsFile())
+        {
+            error = "Preset file not found: " + file.getFullPathName();
+            return false;
+        }
+
+        juce::StringArray lines;
+        file.readLines (lines);
+
+        for (auto line : lines)
+        {
+            line = line.trim();
+
+            if (line.isEmpty() || line.startsWithChar ('#'))
+                continue;
+
+            if (! line.containsChar ('='))
+            {
+                error = "Malformed preset line: " + line;
+                return false;
+            }
+
+            settings.parameterValues.emplace_back (line.upToFirstOccurrenceOf ("=", false, false).trim(),
+                                                   line.fromFirstOccurrenceOf ("=", false, false).trim().getFloatValue());
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    std::unique_ptr<juce::AudioFormatReader> createReader (juce::AudioFormatManager& formats, const juce::File& file)
+    {
+        // Memory-mapped where the format supports it, so large stems aren't copied through a stream
+        if (auto* format = formats.findFormatForFileExtension (file.getFileExtension()))
+        {
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped (format->createMemoryMappedReader (file));
+
+            if (mapped != nullptr && mapped->mapEntireFile())
+                return mapped;
+        }
+
+        return std::unique_ptr<juce::AudioFormatReader> (formats.createReaderFor (file));
+    }
+
+    RenderResult renderFile (OverDrive4AudioProcessor& processor, juce::AudioFormatManager& formats,
+                             const juce::File& input, const RenderSettings& settings)
+    {
+        RenderResult result;
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        auto reader = createReader (formats, input);
+
+        if (reader == nullptr)
+        {
+            result.message = "can't read file";
+            return result;
+        }
+
+        // The processor takes the file's own channel layout
+        const auto fileChannels = (int) reader->numChannels;
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add (juce::AudioChannelSet::canonicalChannelSet (fileChannels));
+        layout.outputBuses.add (juce::AudioChannelSet::canonicalChannelSet (fileChannels));
+
+        if (! processor.setBusesLayout (layout))
+        {
+            result.message = "unsupported channel count (" + juce::String (fileChannels) + ")";
+            return result;
+        }
+
+        auto output = settings.outputDirectory.getChildFile (input.getFileName());
+
+        if (output == input)
+        {
+            result.message = "output would overwrite the input";
+            return result;
+        }
+
+        auto* format = formats.findFormatForFileExtension (input.getFileExtension());
+        output.deleteFile();
+        auto stream = std::make_unique<juce::FileOutputStream> (output);
+        const auto bitsPerSample = reader->usesFloatingPointData ? 32 : (int) reader->bitsPerSample;
+
+        std::unique_ptr<juce::AudioFormatWriter> writer (stream->openedOk() ? format->createWriterFor (stream.get(), reader->sampleRate,
+                                                                                                         (unsigned int) fileChannels,
+                                                                                                         bitsPerSample, {}, 0)
+                                                                             : nullptr);
+        if (writer == nullptr)
+        {
+            result.message = "can't create " + output.getFullPathName();
+            return result;
+        }
+
+        stream.release(); // Now owned by the writer
+
+        processor.setNonRealtime (true);
+        processor.prepareToPlay (reader->sampleRate, settings.blockSize);
+
+        // The processor's latency is trimmed from the start and its tail is rendered past the end,
+        // so the output lines up with the input sample for sample
+        const auto inputLength = reader->lengthInSamples;
+        const auto outputLength = inputLength + (juce::int64) std::ceil (processor.getTailLengthSeconds() * reader->sampleRate);
+        auto samplesToSkip = (juce::int64) processor.getLatencySamples();
+        const auto skippedBefore = processor.getNumSkippedBlocks();
+
+        juce::AudioBuffer<float> buffer (fileChannels, settings.blockSize);
+        juce::MidiBuffer midi;
+        juce::int64 readPosition = 0, written = 0;
+
+        while (written < outputLength)
+        {
+            buffer.clear();
+
+            const auto numToRead = (int) juce::jlimit ((juce::int64) 0, (juce::int64) settings.blockSize, inputLength - readPosition);
+
+            if (numToRead > 0)
+                reader->read (&buffer, 0, numToRead, readPosition, true, true);
+
+            readPosition += settings.blockSize;
+            processor.processBlock (buffer, midi);
+
+            const auto skipped = (int) juce::jmin (samplesToSkip, (juce::int64) settings.blockSize);
+            samplesToSkip -= skipped;
+
+            const auto numToWrite = (int) juce::jmin ((juce::int64) (settings.blockSize - skipped), outputLength - written);
+
+            if (numToWrite > 0)
+            {
+                writer->writeFromAudioSampleBuffer (buffer, skipped, numToWrite);
+                written += numToWrite;
+            }
+        }
+
+        processor.releaseResources();
+
+        result.succeeded = true;
+        result.skippedBlocks = processor.getNumSkippedBlocks() - skippedBefore;
+        result.audioSeconds = (double) inputLength / reader->sampleRate;
+        result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        return result;
+    }
+
+    //==============================================================================
+    /** Shared by all workers: the files still to render and the totals so far. */
+    struct RenderQueue
+    {
+        juce::Array<juce::File> files;
+        std::atomic<int> nextFile { 0 };
+
+        juce::CriticalSection reportLock;
+        double totalAudioSeconds = 0.0;
+        int numFailed = 0;
+
+        void report (const juce::File& file, const RenderResult& result)
+        {
+            const juce::ScopedLock sl (reportLock);
+
+            if (result.succeeded)
+            {
+                totalAudioSeconds += result.audioSeconds;
+                std::cout << file.getFileName() << ": " << juce::String (result.audioSeconds, 1) << " s in "
+                          << juce::String (result.renderSeconds, 2) << " s ("
+                          << juce::String (result.audioSeconds / juce::jmax (1.0e-6, result.renderSeconds), 1) << "x realtime, "
+                          << (juce::int64) result.skippedBlocks << " silent blocks skipped)" << std::endl;
+            }
+            else
+            {
+                ++numFailed;
+                std::cerr << file.getFileName() << ": " << result.message << std::endl;
+            }
+        }
+    };
+
+    /** One processor instance, pulling files from the queue until it is empty.
+        The processor is created and destroyed on the main thread, as its parameter
+        state owns a Timer.
+    */
+    class RenderWorker : public juce::ThreadPoolJob
+    {
+    public:
+        RenderWorker (OverDrive4AudioProcessor& p, RenderQueue& q, const RenderSettings& s)
+            : juce::ThreadPoolJob ("OverDrive render worker"), processor (p), queue (q), settings (s)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            juce::AudioFormatManager formats;
+            formats.registerBasicFormats();
+
+            for (auto index = queue.nextFile++; index < queue.files.size() && ! shouldExit(); index = queue.nextFile++)
+            {
+                const auto& file = queue.files.getReference (index);
+                queue.report (file, renderFile (processor, formats, file, settings));
+            }
+
+            return jobHasFinished;
+        }
+
+    private:
+        OverDrive4AudioProcessor& processor;
+        RenderQueue& queue;
+        const RenderSettings& settings;
+    };
+
+    //==============================================================================
+    void runBatch (const juce::ArgumentList& args)
+    {
+        RenderSettings settings;
+        RenderQueue queue;
+
+        if (! args.containsOption ("--output"))
+            juce::ConsoleApplication::fail ("Missing --output=<directory>");
+
+        settings.outputDirectory = args.getExistingFolderForOption ("--output");
+
+        if (args.containsOption ("--block"))
+            settings.blockSize = juce::jlimit (16, 65536, args.getValueForOption ("--block").getIntValue());
+
+        if (args.containsOption ("--preset"))
+        {
+            juce::String error;
+
+            if (! loadPresetFile (args.getExistingFileForOption ("--preset"), settings, error))
+                juce::ConsoleApplication::fail (error);
+        }
+
+        // Any --<PARAMETER_ID>=<value> on the command line overrides the preset
+        OverDrive4AudioProcessor reference;
+
+        for (auto* parameter : reference.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter))
+                if (args.containsOption ("--" + ranged->getParameterID()))
+                    settings.parameterValues.emplace_back (ranged->getParameterID(),
+                                                           args.getValueForOption ("--" + ranged->getParameterID()).getFloatValue());
+
+        for (const auto& [parameterID, value] : settings.parameterValues)
+            if (reference.parameters.getParameter (parameterID) == nullptr)
+                juce::ConsoleApplication::fail ("Unknown parameter: " + parameterID);
+
+        for (const auto& arg : args.arguments)
+        {
+            if (arg.isOption())
+                continue;
+
+            const auto file = arg.resolveAsFile();
+
+            if (file.isDirectory())
+                queue.files.addArray (file.findChildFiles (juce::File::findFiles, false, "*.wav;*.aif;*.aiff"));
+            else if (file.existsAsFile())
+                queue.files.add (file);
+            else
+                juce::ConsoleApplication::fail ("No such file or directory: " + arg.text);
+        }
+
+        if (queue.files.isEmpty())
+            juce::ConsoleApplication::fail ("No input files");
+
+        const auto numThreads = juce::jlimit (1, queue.files.size(),
+                                              args.containsOption ("--threads") ? args.getValueForOption ("--threads").getIntValue()
+                                                                                : juce::SystemStats::getNumCpus());
+
+        std::vector<std::unique_ptr<OverDrive4AudioProcessor>> processors;
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            processors.push_back (std::make_unique<OverDrive4AudioProcessor>());
+            applyParameters (*processors.back(), settings);
+        }
+
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        {
+            juce::ThreadPool pool (numThreads);
+
+            for (auto& processor : processors)
+                pool.addJob (new RenderWorker (*processor, queue, settings), true);
+
+            while (pool.getNumJobs() > 0)
+                juce::Thread::sleep (50);
+        }
+
+        const auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+        std::cout << "Rendered " << (queue.files.size() - queue.numFailed) << " of " << queue.files.size() << " files, "
+                  << juce::String (queue.totalAudioSeconds, 1) << " s of audio in " << juce::String (wallSeconds, 2) << " s on "
+                  << numThreads << " threads: "
+                  << juce::String (queue.totalAudioSeconds / juce::jmax (1.0e-6, wallSeconds), 1) << "x realtime" << std::endl;
+
+        if (queue.numFailed > 0)
+            juce::ConsoleApplication::fail (juce::String (queue.numFailed) + " file(s) failed");
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor's parameter state and async updates need a message manager, even without a UI
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand ("--help|-h", "OverDrive batch renderer", true);
+
+    app.addCommand ({ "--render",
+                      "--render <files or folders> --output=<folder> [--preset=<file>] [--threads=<n>] [--block=<n>] [--<PARAMETER_ID>=<value>]",
+                      "Renders WAV/AIFF files through OverDrive.",
+                      "Files are processed in parallel, one processor instance per thread. Parameters are plain values, "
+                      "e.g. --DRIVE=6.5 --MIX=40 --OVERSAMPLING=2. A preset file holds one PARAMETER_ID=value per line.",
+                      [] (const juce::ArgumentList& args) { runBatch (args); } });
+
+    return app.findAndRunCommand (argc, argv);
+}
@@ -0,0 +1,645 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  Bradley Smith
+
+    Micro-benchmarks for the DSP path. Times the whole processor and each of its
+    stages (saturation, HPF, LPF, mix) over a grid of block sizes, sample rates,
+    channel counts and parameter settings, and can compare a run against an
+    earlier JSON report to catch regressions. --aliasing measures how well each
+    oversampling/ADAA combination suppresses aliasing, next to its CPU cost.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+namespace
+{
+    struct BenchmarkCase
+    {
+        juce::String stage, settings;
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numChannels = 2;
+
+        juce::String getKey() const
+        {
+            return stage + "/" + settings + "/" + juce::String ((int) sampleRate) + "/" + juce::String (blockSize) + "/" + juce::String (numChannels);
+        }
+    };
+
+    struct Measurement
+    {
+        BenchmarkCase benchmarkCase;
+        double nanosecondsPerSample = 0.0;  // Per sample of one channel
+        double realtimeFactor = 0.0;        // Seconds of audio processed per second of CPU time
+    };
+
+    struct Grid
+    {
+        juce::Array<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+        juce::Array<double> sampleRates { 44100.0, 48000.0, 96000.0, 192000.0 };
+        juce::Array<int> channelCounts { 1, 2, 8, 16 };
+        juce::StringArray stages { "processor", "saturation", "highpass", "lowpass", "mix" };
+        double audioSeconds = 0.25;         // Audio processed per timed round
+        int numRounds = 5;
+    };
+
+    // Parameter settings swept for the whole processor. Plain values, as in the batch renderer.
+    struct ProcessorSettings
+    {
+        const char* name;
+        std::vector<std::pair<juce::String, float>> values;
+        bool automated;
+        bool referencePipeline;
+    };
+
+    const ProcessorSettings processorSettings[] =
+    {
+        { "default",         {},                                                   false, false },
+        { "fast",            { { "SAT_ACCURACY", 0.0f } },                         false, false },
+        { "reference",       {},                                                   false, true  },
+        { "automated",       {},                                                   true,  false },
+        { "oversampled",     { { "OVERSAMPLING", 2.0f } },                         false, false },
+        { "oversampled-fir", { { "OVERSAMPLING", 2.0f }, { "OS_FILTER", 1.0f } },  false, false },
+        { "tube",            { { "CURVE", 1.0f } },                                false, false },
+        { "foldback",        { { "CURVE", 4.0f } },                                false, false },
+        { "adaa1",           { { "ANTIALIASING", 1.0f } },                         false, false },
+        { "adaa2",           { { "ANTIALIASING", 2.0f } },                         false, false },
+        { "adaa1-2x",        { { "ANTIALIASING", 1.0f }, { "OVERSAMPLING", 1.0f } }, false, false },
+        { "48db",            { { "HPF_SLOPE", 3.0f }, { "LPF_SLOPE", 3.0f } },     false, false },
+        { "48db-automated",  { { "HPF_SLOPE", 3.0f }, { "LPF_SLOPE", 3.0f } },     true,  false },
+        { "2band",           { { "BANDS", 1.0f } },                                false, false },
+        { "4band",           { { "BANDS", 3.0f } },                                false, false },
+        { "4band-automated", { { "BANDS", 3.0f } },                                true,  false },
+        { "eco",             { { "QUALITY", 1.0f } },                              false, false },
+        { "live",            { { "QUALITY", 2.0f } },                              false, false },
+        { "render",          { { "QUALITY", 3.0f } },                              false, false },
+        { "diode",           { { "DRIVE_MODEL", 1.0f } },                          false, false },
+        { "diode-2x",        { { "DRIVE_MODEL", 1.0f }, { "OVERSAMPLING", 1.0f } }, false, false },
+    };
+
+    const std::pair<const char*, SaturationKernel::Accuracy> saturationSettings[] =
+    {
+        { "fast",     SaturationKernel::Accuracy::fast },
+        { "balanced", SaturationKernel::Accuracy::balanced },
+        { "accurate", SaturationKernel::Accuracy::accurate },
+    };
+
+    //==============================================================================
+    /** Noise at -6 dBFS, the same for every run so results are comparable. */
+    void fillSource (juce::AudioBuffer<float>& source)
+    {
+        juce::Random random (0x0d0d);
+
+        for (int channel = 0; channel < source.getNumChannels(); ++channel)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                source.setSample (channel, i, random.nextFloat() - 0.5f);
+    }
+
+    /** Runs processBlockFn over the source audio one block at a time, once to warm
+        up and then numRounds times, and returns the median time of a round.
+        The audio is restored between rounds, outside the timed region.
+    */
+    template <typename ProcessBlockFn>
+    Measurement timeBlocks (const BenchmarkCase& benchmarkCase, const Grid& grid, ProcessBlockFn&& processBlockFn)
+    {
+        const auto totalSamples = juce::roundToInt (grid.audioSeconds * benchmarkCase.sampleRate);
+
+        juce::AudioBuffer<float> source (benchmarkCase.numChannels, totalSamples);
+        juce::AudioBuffer<float> work (benchmarkCase.numChannels, totalSamples);
+        fillSource (source);
+
+        std::vector<double> roundSeconds;
+
+        for (int round = 0; round <= grid.numRounds; ++round)
+        {
+            work.makeCopyOf (source, true);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            for (int startSample = 0; startSample < totalSamples; startSample += benchmarkCase.blockSize)
+            {
+                juce::AudioBuffer<float> block (work.getArrayOfWritePointers(), benchmarkCase.numChannels, startSample,
+                                                juce::jmin (benchmarkCase.blockSize, totalSamples - startSample));
+                processBlockFn (block);
+            }
+
+            const auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+
+            if (round > 0)
+                roundSeconds.push_back (seconds);
+        }
+
+        std::sort (roundSeconds.begin(), roundSeconds.end());
+        const auto median = roundSeconds[roundSeconds.size() / 2];
+
+        Measurement result;
+        result.benchmarkCase = benchmarkCase;
+        result.nanosecondsPerSample = median * 1.0e9 / ((double) totalSamples * benchmarkCase.numChannels);
+        result.realtimeFactor = grid.audioSeconds / juce::jmax (1.0e-12, median);
+        return result;
+    }
+
+    //==============================================================================
+    void setParameters (OverDrive4AudioProcessor& processor, const std::vector<std::pair<juce::String, float>>& values)
+    {
+        for (const auto& [parameterID, value] : values)
+            if (auto* parameter = processor.parameters.getParameter (parameterID))
+                parameter->setValueNotifyingHost (parameter->convertTo0to1 (value));
+    }
+
+    Measurement benchmarkProcessor (const BenchmarkCase& benchmarkCase, const ProcessorSettings& settings, const Grid& grid)
+    {
+        OverDrive4AudioProcessor processor;
+        setParameters (processor, settings.values);
+
+        processor.setPipeline (settings.referencePipeline ? OverDrive4AudioProcessor::Pipeline::reference
+                                                          : OverDrive4AudioProcessor::Pipeline::fused);
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add (juce::AudioChannelSet::canonicalChannelSet (benchmarkCase.numChannels));
+        layout.outputBuses.add (juce::AudioChannelSet::canonicalChannelSet (benchmarkCase.numChannels));
+
+        if (! processor.setBusesLayout (layout))
+            juce::ConsoleApplication::fail ("Unsupported channel count: " + juce::String (benchmarkCase.numChannels));
+
+        processor.setRateAndBufferSizeDetails (benchmarkCase.sampleRate, benchmarkCase.blockSize);
+        processor.prepareToPlay (benchmarkCase.sampleRate, benchmarkCase.blockSize);
+
+        auto* drive = processor.parameters.getParameter ("DRIVE");
+        auto* highPass = processor.parameters.getParameter ("HPF_FREQ");
+        juce::MidiBuffer midi;
+        int blockIndex = 0;
+
+        auto result = timeBlocks (benchmarkCase, grid, [&] (juce::AudioBuffer<float>& block)
+        {
+            // Keep the smoothers moving so the ramped paths are exercised
+            if (settings.automated)
+            {
+                const auto phase = (float) (blockIndex++ % 64) / 64.0f;
+                drive->setValueNotifyingHost (phase);
+                highPass->setValueNotifyingHost (phase * 0.5f);
+            }
+
+            processor.processBlock (block, midi);
+        });
+
+        processor.releaseResources();
+        return result;
+    }
+
+    Measurement benchmarkSaturation (const BenchmarkCase& benchmarkCase, SaturationKernel::Accuracy accuracy, const Grid& grid)
+    {
+        SaturationKernel saturation;
+        saturation.setAccuracy (accuracy);
+
+        return timeBlocks (benchmarkCase, grid, [&] (juce::AudioBuffer<float>& block)
+        {
+            for (int channel = 0; channel < block.getNumChannels(); ++channel)
+                saturation.process (block.getReadPointer (channel), block.getWritePointer (channel), block.getNumSamples(), 5.0f, 1.0f);
+        });
+    }
+
+    template <bool isHighPass>
+    Measurement benchmarkFilter (const BenchmarkCase& benchmarkCase, const Grid& grid)
+    {
+        const auto coefficients = TPTCoefficients<float>::make (benchmarkCase.sampleRate, isHighPass ? 200.0 : 8000.0, 0.7);
+        std::vector<TPTState<float>> states ((size_t) benchmarkCase.numChannels);
+
+        return timeBlocks (benchmarkCase, grid, [&] (juce::AudioBuffer<float>& block)
+        {
+            for (int channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                auto* data = block.getWritePointer (channel);
+                auto& state = states[(size_t) channel];
+
+                for (int i = 0; i < block.getNumSamples(); ++i)
+                    data[i] = isHighPass ? processTPTHighPass (data[i], coefficients, state.s1, state.s2)
+                                         : processTPTLowPass (data[i], coefficients, state.s1, state.s2);
+
+                juce::dsp::util::snapToZero (state.s1);
+                juce::dsp::util::snapToZero (state.s2);
+            }
+        });
+    }
+
+    Measurement benchmarkMix (const BenchmarkCase& benchmarkCase, const Grid& grid)
+    {
+        juce::AudioBuffer<float> wet (benchmarkCase.numChannels, benchmarkCase.blockSize);
+        fillSource (wet);
+
+        return timeBlocks (benchmarkCase, grid, [&] (juce::AudioBuffer<float>& block)
+        {
+            for (int channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                juce::FloatVectorOperations::multiply (block.getWritePointer (channel), 0.5f, block.getNumSamples());
+                juce::FloatVectorOperations::addWithMultiply (block.getWritePointer (channel), wet.getReadPointer (channel),
+                                                              0.5f, block.getNumSamples());
+            }
+        });
+    }
+
+    //==============================================================================
+    juce::String formatRow (const Measurement& m)
+    {
+        const auto& c = m.benchmarkCase;
+
+        return c.stage.paddedRight (' ', 12) + c.settings.paddedRight (' ', 17)
+             + juce::String ((int) c.sampleRate).paddedLeft (' ', 7) + juce::String (c.blockSize).paddedLeft (' ', 7)
+             + juce::String (c.numChannels).paddedLeft (' ', 5)
+             + juce::String (m.nanosecondsPerSample, 2).paddedLeft (' ', 12)
+             + juce::String (m.realtimeFactor, 1).paddedLeft (' ', 12);
+    }
+
+    juce::String toCSV (const juce::Array<Measurement>& results)
+    {
+        juce::String csv ("stage,settings,sample_rate,block_size,channels,ns_per_sample,realtime_factor\n");
+
+        for (const auto& m : results)
+        {
+            const auto& c = m.benchmarkCase;
+            csv << c.stage << "," << c.settings << "," << (int) c.sampleRate << "," << c.blockSize << "," << c.numChannels << ","
+                << juce::String (m.nanosecondsPerSample, 3) << "," << juce::String (m.realtimeFactor, 2) << "\n";
+        }
+
+        return csv;
+    }
+
+    juce::String toJSON (const juce::Array<Measurement>& results)
+    {
+        juce::Array<juce::var> cases;
+
+        for (const auto& m : results)
+        {
+            const auto& c = m.benchmarkCase;
+            auto* object = new juce::DynamicObject();
+            object->setProperty ("stage", c.stage);
+            object->setProperty ("settings", c.settings);
+            object->setProperty ("sample_rate", (int) c.sampleRate);
+            object->setProperty ("block_size", c.blockSize);
+            object->setProperty ("channels", c.numChannels);
+            object->setProperty ("ns_per_sample", m.nanosecondsPerSample);
+            object->setProperty ("realtime_factor", m.realtimeFactor);
+            cases.add (juce::var (object));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty ("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty ("instruction_set", SaturationKernel::getInstructionSetName (SaturationKernel::detectInstructionSet()));
+        root->setProperty ("juce_version", juce::SystemStats::getJUCEVersion());
+        root->setProperty ("cases", cases);
+
+        return juce::JSON::toString (juce::var (root));
+    }
+
+    /** Compares against a report written with --json. Returns the number of cases
+        that got slower by more than thresholdPercent.
+    */
+    int compareWithBaseline (const juce::Array<Measurement>& results, const juce::File& baselineFile, double thresholdPercent)
+    {
+        const auto baseline = juce::JSON::parse (baselineFile);
+
+        if (! baseline.isObject())
+            juce::ConsoleApplication::fail ("Can't parse baseline " + baselineFile.getFullPathName());
+
+        std::map<juce::String, double> baselineTimes;
+
+        if (auto* cases = baseline["cases"].getArray())
+        {
+            for (const auto& c : *cases)
+            {
+                BenchmarkCase key { c["stage"].toString(), c["settings"].toString(), (double) c["sample_rate"], (int) c["block_size"], (int) c["channels"] };
+                baselineTimes[key.getKey()] = (double) c["ns_per_sample"];
+            }
+        }
+
+        int numRegressions = 0;
+
+        for (const auto& m : results)
+        {
+            const auto found = baselineTimes.find (m.benchmarkCase.getKey());
+
+            if (found == baselineTimes.end() || found->second <= 0.0)
+                continue;
+
+            const auto changePercent = (m.nanosecondsPerSample / found->second - 1.0) * 100.0;
+
+            if (changePercent > thresholdPercent)
+            {
+                ++numRegressions;
+                std::cout << "SLOWER " << m.benchmarkCase.getKey() << ": " << juce::String (found->second, 2) << " -> "
+                          << juce::String (m.nanosecondsPerSample, 2) << " ns/sample (+" << juce::String (changePercent, 1) << "%)" << std::endl;
+            }
+        }
+
+        return numRegressions;
+    }
+
+    //==============================================================================
+    juce::Array<int> parseIntList (const juce::String& list)
+    {
+        juce::Array<int> values;
+
+        for (const auto& item : juce::StringArray::fromTokens (list, ",", {}))
+            values.add (item.getIntValue());
+
+        return values;
+    }
+
+    void runBenchmarks (const juce::ArgumentList& args)
+    {
+        Grid grid;
+
+        if (args.containsOption ("--quick"))
+        {
+            grid.blockSizes = { 64, 512, 4096 };
+            grid.sampleRates = { 48000.0, 96000.0 };
+            grid.channelCounts = { 2 };
+            grid.audioSeconds = 0.1;
+        }
+
+        if (args.containsOption ("--blocks"))
+            grid.blockSizes = parseIntList (args.getValueForOption ("--blocks"));
+
+        if (args.containsOption ("--rates"))
+        {
+            grid.sampleRates.clear();
+
+            for (auto rate : parseIntList (args.getValueForOption ("--rates")))
+                grid.sampleRates.add ((double) rate);
+        }
+
+        if (args.containsOption ("--channels"))
+            grid.channelCounts = parseIntList (args.getValueForOption ("--channels"));
+
+        if (args.containsOption ("--stages"))
+            grid.stages = juce::StringArray::fromTokens (args.getValueForOption ("--stages"), ",", {});
+
+        if (args.containsOption ("--seconds"))
+            grid.audioSeconds = juce::jlimit (0.01, 60.0, args.getValueForOption ("--seconds").getDoubleValue());
+
+        std::cout << "CPU: " << juce::SystemStats::getCpuModel() << ", saturation kernel: "
+                  << SaturationKernel::getInstructionSetName (SaturationKernel::detectInstructionSet()) << std::endl << std::endl
+                  << "stage       settings            rate  block   ch   ns/sample  x realtime" << std::endl;
+
+        juce::Array<Measurement> results;
+
+        auto add = [&results] (const Measurement& m)
+        {
+            results.add (m);
+            std::cout << formatRow (m) << std::endl;
+        };
+
+        for (const auto& stage : grid.stages)
+        {
+            for (auto sampleRate : grid.sampleRates)
+            {
+                for (auto blockSize : grid.blockSizes)
+                {
+                    for (auto numChannels : grid.channelCounts)
+                    {
+                        BenchmarkCase benchmarkCase { stage, "default", sampleRate, juce::jlimit (1, 65536, blockSize), juce::jmax (1, numChannels) };
+
+                        if (stage == "processor")
+                        {
+                            for (const auto& settings : processorSettings)
+                            {
+                                benchmarkCase.settings = settings.name;
+                                add (benchmarkProcessor (benchmarkCase, settings, grid));
+                            }
+                        }
+                        else if (stage == "saturation")
+                        {
+                            for (const auto& [name, accuracy] : saturationSettings)
+                            {
+                                benchmarkCase.settings = name;
+                                add (benchmarkSaturation (benchmarkCase, accuracy, grid));
+                            }
+                        }
+                        else if (stage == "highpass")   add (benchmarkFilter<true> (benchmarkCase, grid));
+                        else if (stage == "lowpass")    add (benchmarkFilter<false> (benchmarkCase, grid));
+                        else if (stage == "mix")        add (benchmarkMix (benchmarkCase, grid));
+                        else                            juce::ConsoleApplication::fail ("Unknown stage: " + stage);
+                    }
+                }
+            }
+        }
+
+        if (args.containsOption ("--csv"))
+            args.getFileForOption ("--csv").replaceWithText (toCSV (results));
+
+        if (args.containsOption ("--json"))
+            args.getFileForOption ("--json").replaceWithText (toJSON (results));
+
+        if (args.containsOption ("--baseline"))
+        {
+            const auto threshold = args.containsOption ("--threshold") ? args.getValueForOption ("--threshold").getDoubleValue() : 10.0;
+            const auto numRegressions = compareWithBaseline (results, args.getExistingFileForOption ("--baseline"), threshold);
+
+            if (numRegressions > 0)
+                juce::ConsoleApplication::fail (juce::String (numRegressions) + " case(s) slower than the baseline by more than "
+                                                + juce::String (threshold, 1) + "%");
+
+            std::cout << "No case slower than the baseline by more than " << juce::String (threshold, 1) << "%" << std::endl;
+        }
+    }
+
+    //==============================================================================
+    // Anti-aliasing options compared by --aliasing
+    struct AntialiasingMode
+    {
+        const char* name;
+        int oversamplingIndex;
+        int antialiasingOrder;
+    };
+
+    const AntialiasingMode antialiasingModes[] =
+    {
+        { "off",      0, 0 },
+        { "2x",       1, 0 },
+        { "4x",       2, 0 },
+        { "8x",       3, 0 },
+        { "adaa1",    0, 1 },
+        { "adaa2",    0, 2 },
+        { "adaa1-2x", 1, 1 },
+        { "adaa2-2x", 1, 2 },
+    };
+
+    struct ToneMeasurement
+    {
+        double frequency = 0.0;
+        double thdPlusNoiseDecibels = 0.0;  // Everything but the fundamental, 20 Hz - 20 kHz
+        double aliasingDecibels = 0.0;      // Everything but the fundamental and its harmonics
+    };
+
+    /** Plays a sine through the processor until it settles, then measures the
+        distortion in one windowed FFT frame. The tone sits on an odd bin centre,
+        so its aliases can't land on its own harmonics, and the analysis ignores
+        a few bins either side of each harmonic, so window leakage doesn't count
+        as aliasing.
+    */
+    ToneMeasurement measureTone (OverDrive4AudioProcessor& processor, double sampleRate, double frequency)
+    {
+        constexpr int fftOrder = 15;
+        constexpr int fftSize = 1 << fftOrder;
+        constexpr int blockSize = 512;
+        constexpr double halfWidthBins = 6.0;
+
+        const auto binHz = sampleRate / fftSize;
+        const auto bin = (int) std::round (frequency / binHz);
+        frequency = (bin | 1) * binHz;
+
+        const auto settleSamples = juce::roundToInt (0.25 * sampleRate);
+        juce::AudioBuffer<float> tone (1, settleSamples + fftSize);
+
+        for (int i = 0; i < tone.getNumSamples(); ++i)
+            tone.setSample (0, i, (float) std::sin (juce::MathConstants<double>::twoPi * frequency * i / sampleRate));
+
+        juce::MidiBuffer midi;
+
+        for (int startSample = 0; startSample < tone.getNumSamples(); startSample += blockSize)
+        {
+            juce::AudioBuffer<float> block (tone.getArrayOfWritePointers(), 1, startSample,
+                                            juce::jmin (blockSize, tone.getNumSamples() - startSample));
+            processor.processBlock (block, midi);
+        }
+
+        std::vector<float> frame (2 * fftSize, 0.0f);
+        std::copy (tone.getReadPointer (0, settleSamples), tone.getReadPointer (0, settleSamples) + fftSize, frame.begin());
+
+        juce::dsp::WindowingFunction<float> window ((size_t) fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris, false);
+        window.multiplyWithWindowingTable (frame.data(), (size_t) fftSize);
+
+        juce::dsp::FFT fft (fftOrder);
+        fft.performFrequencyOnlyForwardTransform (frame.data(), true);
+
+        const auto fundamentalBin = frequency / binHz;
+        const auto lowestBin = (int) std::ceil (20.0 / binHz);
+        const auto highestBin = juce::jmin (fftSize / 2 - 1, (int) (20000.0 / binHz));
+
+        double fundamental = 0.0, distortion = 0.0, aliasing = 0.0;
+
+        for (int bin = lowestBin; bin <= highestBin; ++bin)
+        {
+            const auto power = (double) frame[(size_t) bin] * frame[(size_t) bin];
+
+            // Distance to the nearest multiple of the fundamental, which is a true harmonic
+            const auto harmonic = std::round (bin / fundamentalBin);
+            const auto isHarmonic = harmonic >= 1.0 && std::abs (bin - harmonic * fundamentalBin) <= halfWidthBins;
+
+            if (harmonic == 1.0 && isHarmonic)
+                fundamental += power;
+            else
+                distortion += power;
+
+            if (! isHarmonic)
+                aliasing += power;
+        }
+
+        auto relativeDecibels = [fundamental] (double power)
+        {
+            return 10.0 * std::log10 (juce::jmax (1.0e-30, power) / juce::jmax (1.0e-30, fundamental));
+        };
+
+        return { frequency, relativeDecibels (distortion), relativeDecibels (aliasing) };
+    }
+
+    void runAliasingMeasurements (const juce::ArgumentList& args)
+    {
+        const auto sampleRate = args.containsOption ("--rate") ? juce::jlimit (22050.0, 384000.0, args.getValueForOption ("--rate").getDoubleValue())
+                                                               : 48000.0;
+        const auto drive = args.containsOption ("--drive") ? juce::jlimit (0.0f, 10.0f, args.getValueForOption ("--drive").getFloatValue()) : 5.0f;
+
+        // A stepped sweep over the top of the audio band, where aliasing is worst
+        juce::Array<double> frequencies;
+
+        for (auto frequency = 2000.0; frequency <= juce::jmin (18000.0, 0.45 * sampleRate); frequency += 2000.0)
+            frequencies.add (frequency);
+
+        Grid grid;
+        grid.audioSeconds = 0.1;
+
+        std::cout << "Sine sweep " << (int) frequencies.getFirst() << "-" << (int) frequencies.getLast() << " Hz at " << (int) sampleRate
+                  << " Hz, drive " << drive << ", 100% wet. dB relative to the fundamental." << std::endl << std::endl
+                  << "mode        worst THD+N  mean THD+N  worst alias  mean alias   ns/sample" << std::endl;
+
+        juce::String csv ("mode,frequency,thd_plus_noise_db,aliasing_db\n");
+
+        for (const auto& mode : antialiasingModes)
+        {
+            const std::vector<std::pair<juce::String, float>> values { { "DRIVE", drive }, { "GAIN", 0.0f }, { "MIX", 100.0f },
+                                                                       { "OVERSAMPLING", (float) mode.oversamplingIndex },
+                                                                       { "ANTIALIASING", (float) mode.antialiasingOrder } };
+            OverDrive4AudioProcessor processor;
+            setParameters (processor, values);
+
+            juce::AudioProcessor::BusesLayout layout;
+            layout.inputBuses.add (juce::AudioChannelSet::mono());
+            layout.outputBuses.add (juce::AudioChannelSet::mono());
+            processor.setBusesLayout (layout);
+            processor.setRateAndBufferSizeDetails (sampleRate, 512);
+            processor.prepareToPlay (sampleRate, 512);
+
+            auto worstDistortion = -400.0, worstAliasing = -400.0, distortionSum = 0.0, aliasingSum = 0.0;
+
+            for (auto frequency : frequencies)
+            {
+                const auto m = measureTone (processor, sampleRate, frequency);
+                worstDistortion = juce::jmax (worstDistortion, m.thdPlusNoiseDecibels);
+                worstAliasing = juce::jmax (worstAliasing, m.aliasingDecibels);
+                distortionSum += m.thdPlusNoiseDecibels;
+                aliasingSum += m.aliasingDecibels;
+
+                csv << mode.name << "," << juce::String (m.frequency, 1) << "," << juce::String (m.thdPlusNoiseDecibels, 2) << ","
+                    << juce::String (m.aliasingDecibels, 2) << "\n";
+            }
+
+            processor.releaseResources();
+
+            const ProcessorSettings settings { mode.name, values, false, false };
+            const auto cost = benchmarkProcessor ({ "processor", mode.name, sampleRate, 512, 2 }, settings, grid);
+            const auto numTones = (double) frequencies.size();
+
+            std::cout << juce::String (mode.name).paddedRight (' ', 10)
+                      << juce::String (worstDistortion, 1).paddedLeft (' ', 13) << juce::String (distortionSum / numTones, 1).paddedLeft (' ', 12)
+                      << juce::String (worstAliasing, 1).paddedLeft (' ', 13) << juce::String (aliasingSum / numTones, 1).paddedLeft (' ', 12)
+                      << juce::String (cost.nanosecondsPerSample, 2).paddedLeft (' ', 12) << std::endl;
+        }
+
+        if (args.containsOption ("--csv"))
+            args.getFileForOption ("--csv").replaceWithText (csv);
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand ("--help|-h", "OverDrive benchmarks", false);
+
+    app.addDefaultCommand ({ "--run",
+                             "[--quick] [--stages=a,b] [--blocks=n,n] [--rates=n,n] [--channels=n,n] [--seconds=s] "
+                             "[--csv=<file>] [--json=<file>] [--baseline=<json> [--threshold=<percent>]]",
+                             "Times the processor and its stages.",
+                             "Stages are processor, saturation, highpass, lowpass and mix. Times are the median of several rounds, "
+                             "in nanoseconds per sample per channel. With --baseline, the run fails if any case is slower than the "
+                             "same case in an earlier --json report by more than --threshold percent (default 10).",
+                             [] (const juce::ArgumentList& args) { runBenchmarks (args); } });
+
+    app.addCommand ({ "--aliasing",
+                      "--aliasing [--rate=<hz>] [--drive=<0-10>] [--csv=<file>]",
+                      "Measures THD+N, aliasing and CPU cost of each anti-aliasing mode.",
+                      "Plays a stepped sine sweep from 2 kHz up through the processor at 100% wet for each combination of "
+                      "oversampling and ADAA, and reports the distortion (THD+N) and the inharmonic part of it (aliasing) "
+                      "relative to the fundamental, with the processor's cost in ns/sample. --csv writes the per-tone results.",
+                      [] (const juce::ArgumentList& args) { runAliasingMeasurements (args); } });
+
+    return app.findAndRunCommand (argc, argv);
+}
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    CurveEditor.cpp
+    Created: 17 Oct 2026 7:20:44pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "CurveEditor.h"
+
+namespace
+{
+    const auto curveColour = juce::Colour::fromRGB (0, 255, 255);
+
+    // Input range shown: the user curve is defined over +/-1, the others are
+    // shown over a wider range so their knee and folds are visible
+    float getPlotRange (WaveshaperCurve curve)
+    {
+        return curve == WaveshaperCurve::user ? 1.0f : 4.0f;
+    }
+}
+
+CurveEditor::CurveEditor (OverDrive4AudioProcessor& p)
+    : processor (p), drawnCurve (p.getUserCurve())
+{
+    curveBox.addItemList (p.parameters.getParameter ("CURVE")->getAllValueStrings(), 1);
+    curveBox.onChange = [this]
+    {
+        drawnCurve = processor.getUserCurve();
+        repaint();
+    };
+    addAndMakeVisible (curveBox);
+
+    curveAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (processor.parameters, "CURVE", curveBox);
+    processor.addChangeListener (this);
+}
+
+CurveEditor::~CurveEditor()
+{
+    processor.removeChangeListener (this);
+}
+
+void CurveEditor::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    drawnCurve = processor.getUserCurve();
+    repaint();
+}
+
+WaveshaperCurve CurveEditor::getSelectedCurve() const
+{
+    return (WaveshaperCurve) juce::jlimit (0, (int) WaveshaperCurve::user, curveBox.getSelectedItemIndex());
+}
+
+void CurveEditor::paint (juce::Graphics& g)
+{
+    g.setColour (juce::Colours::black.withAlpha (0.25f));
+    g.fillRoundedRectangle (plotArea, 6.0f);
+
+    g.setColour (juce::Colours::grey);
+    g.drawRoundedRectangle (plotArea, 6.0f, 1.0f);
+    g.drawHorizontalLine (juce::roundToInt (plotArea.getCentreY()), plotArea.getX(), plotArea.getRight());
+    g.drawVerticalLine (juce::roundToInt (plotArea.getCentreX()), plotArea.getY(), plotArea.getBottom());
+
+    const auto curve = getSelectedCurve();
+    const auto range = getPlotRange (curve);
+    const auto area = plotArea.reduced (4.0f);
+    juce::Path path;
+
+    for (auto x = area.getX(); x <= area.getRight(); x += 1.0f)
+    {
+        const auto input = juce::jmap (x, area.getX(), area.getRight(), -range, range);
+        const auto output = evaluateWaveshaperCurve (curve, input, &drawnCurve);
+        const auto y = juce::jmap (juce::jlimit (-1.2f, 1.2f, output), -1.2f, 1.2f, area.getBottom(), area.getY());
+
+        if (path.isEmpty())
+            path.startNewSubPath (x, y);
+        else
+            path.lineTo (x, y);
+    }
+
+    g.setColour (curveColour);
+    g.strokePath (path, juce::PathStrokeType (2.0f));
+
+    if (curve == WaveshaperCurve::user)
+    {
+        g.setColour (curveColour.withAlpha (0.6f));
+        g.setFont (11.0f);
+        g.drawText ("Drag to draw", area.removeFromBottom (14.0f), juce::Justification::centredRight);
+    }
+}
+
+void CurveEditor::resized()
+{
+    auto bounds = getLocalBounds();
+    curveBox.setBounds (bounds.removeFromTop (24));
+    bounds.removeFromTop (4);
+    plotArea = bounds.toFloat();
+}
+
+//==============================================================================
+void CurveEditor::mouseDown (const juce::MouseEvent& e)
+{
+    lastDrawnPoint = -1;
+    drawTo (e.position);
+}
+
+void CurveEditor::mouseDrag (const juce::MouseEvent& e)
+{
+    drawTo (e.position);
+}
+
+void CurveEditor::mouseDoubleClick (const juce::MouseEvent& e)
+{
+    if (getSelectedCurve() != WaveshaperCurve::user || ! plotArea.contains (e.position))
+        return;
+
+    drawnCurve = UserCurve();
+    processor.setUserCurve (drawnCurve);
+    repaint();
+}
+
+void CurveEditor::drawTo (juce::Point<float> position)
+{
+    if (getSelectedCurve() != WaveshaperCurve::user)
+        return;
+
+    const auto area = plotArea.reduced (4.0f);
+    const auto point = juce::jlimit (0, UserCurve::numPoints - 1,
+                                     juce::roundToInt (juce::jmap (position.x, area.getX(), area.getRight(), 0.0f, (float) UserCurve::numPoints - 1.0f)));
+    const auto value = juce::jlimit (-1.0f, 1.0f, juce::jmap (position.y, area.getBottom(), area.getY(), -1.2f, 1.2f));
+
+    // Fill in any points skipped by a fast drag
+    const auto from = lastDrawnPoint < 0 ? point : lastDrawnPoint;
+    const auto fromValue = drawnCurve.points[(size_t) from];
+    const auto step = point >= from ? 1 : -1;
+
+    for (int i = from; i != point + step; i += step)
+    {
+        const auto proportion = point == from ? 1.0f : (float) (i - from) / (float) (point - from);
+        drawnCurve.points[(size_t) i] = fromValue + proportion * (value - fromValue);
+    }
+
+    lastDrawnPoint = point;
+    processor.setUserCurve (drawnCurve);
+    drawnCurve = processor.getUserCurve();   // Picks up the pinned centre point
+    repaint();
+}
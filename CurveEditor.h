@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    CurveEditor.h
+    Created: 17 Oct 2026 7:20:44pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+/** Curve selector plus a plot of the selected curve. While the curve is User,
+    dragging across the plot redraws it; double-click resets it to a straight line.
+*/
+class CurveEditor : public juce::Component,
+                    private juce::ChangeListener
+{
+public:
+    explicit CurveEditor (OverDrive4AudioProcessor&);
+    ~CurveEditor() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    void mouseDown (const juce::MouseEvent&) override;
+    void mouseDrag (const juce::MouseEvent&) override;
+    void mouseDoubleClick (const juce::MouseEvent&) override;
+
+private:
+    // A preset or saved state brought in a new user curve
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
+    WaveshaperCurve getSelectedCurve() const;
+    void drawTo (juce::Point<float> position);
+
+    OverDrive4AudioProcessor& processor;
+
+    juce::ComboBox curveBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> curveAttachment;
+
+    juce::Rectangle<float> plotArea;
+    UserCurve drawnCurve;
+    int lastDrawnPoint = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CurveEditor)
+};
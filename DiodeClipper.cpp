@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    DiodeClipper.cpp
+    Created: 18 Oct 2026 3:14:26am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "DiodeClipper.h"
+
+namespace
+{
+    // One-pole TPT coefficient, G = g / (1 + g), with the cutoff kept clear of Nyquist
+    double makeOnePoleCoefficient (double cutoffHz, double sampleRate) noexcept
+    {
+        const auto g = std::tan (juce::MathConstants<double>::pi * juce::jmin (cutoffHz, sampleRate * 0.45) / sampleRate);
+        return g / (1.0 + g);
+    }
+}
+
+void DiodeClipperTable::prepare (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    capacitorConductance = 2.0 * capacitance * sampleRate;
+    conductance = 1.0 / resistance + capacitorConductance;
+
+    const auto maximumCurrent = 2.0 * (12.0 / resistance + 2.0 * capacitorConductance * 1.0);
+    pointsPerAmp = (float) (numPoints / maximumCurrent);
+
+    voltages.resize ((size_t) numPoints + 1);
+
+    // Each point is solved to convergence starting from the last one, with the
+    // steps held to a few nVt so the exponential can't overshoot
+    auto voltage = 0.0;
+
+    for (int i = 0; i <= numPoints; ++i)
+    {
+        const auto current = maximumCurrent * i / numPoints;
+
+        for (int iteration = 0; iteration < 100; ++iteration)
+        {
+            const auto e = std::exp (voltage / diodeVoltage);
+            const auto residual = conductance * voltage + saturationCurrent * (e - 1.0 / e) - current;
+            const auto slope = conductance + saturationCurrent / diodeVoltage * (e + 1.0 / e);
+            const auto step = juce::jmax (-5.0 * diodeVoltage, -residual / slope);
+
+            voltage += juce::jmin (step, 5.0 * diodeVoltage);
+
+            if (std::abs (step) < 1.0e-12)
+                break;
+        }
+
+        voltages[(size_t) i] = (float) voltage;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void DiodeClipper<SampleType>::prepare (int numChannels)
+{
+    state.assign ((size_t) numChannels, {});
+}
+
+template <typename SampleType>
+void DiodeClipper<SampleType>::reset() noexcept
+{
+    std::fill (state.begin(), state.end(), ChannelState());
+}
+
+template <typename SampleType>
+void DiodeClipper<SampleType>::setTable (const DiodeClipperTable* newTable) noexcept
+{
+    // The state is in terms of the old rate's discretisation
+    const auto newSampleRate = newTable != nullptr ? newTable->getSampleRate() : 0.0;
+
+    if (newSampleRate != sampleRate)
+        reset();
+
+    table = newTable;
+    sampleRate = newSampleRate;
+
+    if (table != nullptr)
+        couplingCoefficient = (SampleType) makeOnePoleCoefficient (couplingHz, table->getSampleRate());
+}
+
+template <typename SampleType>
+float DiodeClipper<SampleType>::getToneHz (float tonePercent) noexcept
+{
+    return 500.0f * std::pow (20.0f, juce::jlimit (0.0f, 100.0f, tonePercent) / 100.0f);
+}
+
+template <typename SampleType>
+double DiodeClipper<SampleType>::getTailSeconds (float tonePercent, double decayNepers) noexcept
+{
+    // Three poles in series. The capacitor's is RC at most, and faster while the diodes conduct.
+    const auto twoPi = juce::MathConstants<double>::twoPi;
+    return decayNepers / (twoPi * couplingHz) + decayNepers * DiodeClipperTable::resistance * DiodeClipperTable::capacitance
+         + decayNepers / (twoPi * getToneHz (tonePercent));
+}
+
+template <typename SampleType>
+bool DiodeClipper<SampleType>::hasDecayed (SampleType threshold) const noexcept
+{
+    // The history current settles at 2C fs times the capacitor voltage
+    const auto currentThreshold = table != nullptr ? threshold * (SampleType) table->getCapacitorConductance() : threshold;
+
+    for (const auto& s : state)
+        if (std::abs (s.coupling) > threshold || std::abs (s.tone) > threshold || std::abs (s.capacitorCurrent) > currentThreshold)
+            return false;
+
+    return true;
+}
+
+template <typename SampleType>
+void DiodeClipper<SampleType>::process (int channel, const SampleType* input, SampleType* output, int numSamples, SampleType drive) noexcept
+{
+    jassert (table != nullptr && juce::isPositiveAndBelow (channel, (int) state.size()));
+
+    auto& s = state[(size_t) channel];
+
+    const auto inputConductance = (SampleType) (1.0 / DiodeClipperTable::resistance);
+    const auto capacitorConductance = (SampleType) table->getCapacitorConductance();
+    const auto conductance = (SampleType) table->getConductance();
+    const auto saturationCurrent = (SampleType) DiodeClipperTable::saturationCurrent;
+    const auto diodeConductance = (SampleType) (DiodeClipperTable::saturationCurrent / DiodeClipperTable::diodeVoltage);
+    const auto inverseDiodeVoltage = (SampleType) (1.0 / DiodeClipperTable::diodeVoltage);
+
+    // The tone control moves once per call, so it ramps across the call rather than stepping
+    const auto toneTarget = (SampleType) makeOnePoleCoefficient (toneHz, table->getSampleRate());
+    auto toneCoefficient = s.toneCoefficient < 0 ? toneTarget : s.toneCoefficient;
+    const auto toneIncrement = (toneTarget - toneCoefficient) / (SampleType) juce::jmax (1, numSamples);
+
+    auto coupling = s.coupling, capacitorCurrent = s.capacitorCurrent, tone = s.tone;
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const auto x = drive * input[sample];
+
+        // Coupling: the input less most of what is under couplingHz
+        const auto couplingStep = (x - coupling) * couplingCoefficient;
+        const auto lows = couplingStep + coupling;
+        coupling = lows + couplingStep;
+
+        const auto current = (x - ((SampleType) 1 - bassLevel) * lows) * inputConductance + capacitorCurrent;
+
+        // Newton on (1/R + 2C fs) v + 2 Is sinh (v / nVt) = current
+        auto voltage = table->getStartingVoltage (current);
+
+        for (int iteration = 0; iteration < numIterations; ++iteration)
+        {
+            const auto e = std::exp (voltage * inverseDiodeVoltage);
+            const auto inverseE = (SampleType) 1 / e;
+            const auto residual = conductance * voltage + saturationCurrent * (e - inverseE) - current;
+            voltage -= residual / (conductance + diodeConductance * (e + inverseE));
+        }
+
+        capacitorCurrent = (SampleType) 2 * capacitorConductance * voltage - capacitorCurrent;
+
+        // Tone: one-pole low-pass
+        toneCoefficient += toneIncrement;
+        const auto toneStep = (voltage * outputScale - tone) * toneCoefficient;
+        const auto toned = toneStep + tone;
+        tone = toned + toneStep;
+
+        output[sample] = toned;
+    }
+
+    juce::dsp::util::snapToZero (coupling);
+    juce::dsp::util::snapToZero (tone);
+
+    s.coupling = coupling;
+    s.capacitorCurrent = capacitorCurrent;
+    s.tone = tone;
+    s.toneCoefficient = toneTarget;
+}
+
+//==============================================================================
+template class DiodeClipper<float>;
+template class DiodeClipper<double>;
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    FilterSlopes.cpp
+    Created: 17 Oct 2026 10:06:51pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "FilterSlopes.h"
+
+namespace
+{
+    // Section Qs, by number of sections. Butterworth order 2n has poles at angles
+    // (2k - 1) pi / 4n, so Q = 1 / (2 cos angle). Linkwitz-Riley order 2n is
+    // Butterworth order n twice over; a pair of first-order poles makes a Q 0.5 section.
+    // The 12 dB/oct Butterworth keeps the 0.7 the filters have always used.
+    constexpr std::array<double, maxTPTSections> butterworthResonances[] =
+    {
+        { 0.7 },
+        { 0.54119610, 1.30656296 },
+        { 0.51763809, 0.70710678, 1.93185165 },
+        { 0.50979558, 0.60134489, 0.89997622, 2.56291545 },
+    };
+
+    constexpr std::array<double, maxTPTSections> linkwitzRileyResonances[] =
+    {
+        { 0.5 },
+        { 0.70710678, 0.70710678 },
+        { 0.5, 1.0, 1.0 },
+        { 0.54119610, 0.54119610, 1.30656296, 1.30656296 },
+    };
+}
+
+const std::array<double, maxTPTSections>& FilterSlopes::getSectionResonances (FilterAlignment alignment, int numSections) noexcept
+{
+    const auto index = (size_t) juce::jlimit (1, maxTPTSections, numSections) - 1;
+    return alignment == FilterAlignment::linkwitzRiley ? linkwitzRileyResonances[index] : butterworthResonances[index];
+}
+
+//==============================================================================
+void CutoffTable::prepare (double sampleRate)
+{
+    const auto numOctaves = std::log2 (maximumHz / minimumHz);
+    const auto numPoints = (int) std::ceil (numOctaves * pointsPerOctave) + 1;
+
+    warpedCutoffs.resize ((size_t) numPoints);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto cutoffHz = minimumHz * std::exp2 ((double) i / pointsPerOctave);
+        warpedCutoffs[(size_t) i] = std::tan (juce::MathConstants<double>::pi * juce::jmin (cutoffHz, sampleRate * 0.49) / sampleRate);
+    }
+}
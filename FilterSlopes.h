@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    FilterSlopes.h
+    Created: 17 Oct 2026 10:06:51pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "FusedPipeline.h"
+
+/*  HPF and LPF slopes of 12, 24, 36 or 48 dB/oct, built from one to four TPT
+    SVF sections in series at the same cutoff. Only the sections' Q differs:
+
+        Butterworth         maximally flat, -3 dB at the cutoff
+        Linkwitz-Riley      a Butterworth filter of half the order squared,
+                            -6 dB at the cutoff, so a high-pass and low-pass
+                            at the same frequency sum flat
+
+    Every section shares g = tan (pi * cutoff / sampleRate), so that is the
+    only transcendental in the coefficients. CutoffTable precomputes it on a
+    log-spaced grid of cutoffs when the sample rate is set; the audio thread
+    then smooths a position in that grid and interpolates between two entries
+    at each coefficient update, however steep the slope or fast the sweep.
+*/
+enum class FilterAlignment
+{
+    butterworth,
+    linkwitzRiley
+};
+
+namespace FilterSlopes
+{
+    /** The Q of each of the numSections sections (1 to maxTPTSections) for a
+        slope of 12 * numSections dB/oct.
+    */
+    const std::array<double, maxTPTSections>& getSectionResonances (FilterAlignment alignment, int numSections) noexcept;
+
+    /** The coefficients of a cascade, given g for its cutoff. */
+    template <typename SampleType>
+    TPTCascade<SampleType> makeCascade (double warpedCutoff, FilterAlignment alignment, int numSections) noexcept
+    {
+        TPTCascade<SampleType> cascade;
+        cascade.numSections = juce::jlimit (1, maxTPTSections, numSections);
+
+        const auto& resonances = getSectionResonances (alignment, cascade.numSections);
+
+        for (int section = 0; section < cascade.numSections; ++section)
+            cascade.sections[(size_t) section] = TPTCoefficients<SampleType>::fromWarpedCutoff (warpedCutoff, resonances[(size_t) section]);
+
+        return cascade;
+    }
+}
+
+//==============================================================================
+/** g = tan (pi * cutoff / sampleRate) for cutoffs from minimumHz to maximumHz,
+    in steps of 1/pointsPerOctave of an octave.
+
+    Multiplicative smoothing of a cutoff is linear smoothing of its position in
+    this table, so the DSP smooths positions and only converts a cutoff to a
+    position once per block.
+
+    Once prepared the table is only read, so instances at the same sample rate
+    share one (see SharedResources).
+*/
+class CutoffTable
+{
+public:
+    static constexpr double minimumHz = 20.0;
+    static constexpr double maximumHz = 20000.0;
+    static constexpr int pointsPerOctave = 96;
+
+    /** Fills the table for this sample rate. Allocates, so not on the audio thread. */
+    void prepare (double sampleRate);
+
+    /** The (fractional) position of a cutoff in the table. */
+    static float getPosition (double cutoffHz) noexcept
+    {
+        return (float) (pointsPerOctave * std::log2 (juce::jlimit (minimumHz, maximumHz, cutoffHz) / minimumHz));
+    }
+
+    /** g at a position, interpolated between the two nearest entries. */
+    double getWarpedCutoff (float position) const noexcept
+    {
+        jassert (! warpedCutoffs.empty());
+
+        const auto clamped = juce::jlimit (0.0f, (float) (warpedCutoffs.size() - 1), position);
+        const auto index = juce::jmin ((int) clamped, (int) warpedCutoffs.size() - 2);
+        const auto t = (double) (clamped - (float) index);
+
+        return warpedCutoffs[(size_t) index] + t * (warpedCutoffs[(size_t) index + 1] - warpedCutoffs[(size_t) index]);
+    }
+
+    size_t getMemoryUsage() const noexcept      { return sizeof (*this) + warpedCutoffs.capacity() * sizeof (double); }
+
+private:
+    std::vector<double> warpedCutoffs;
+};
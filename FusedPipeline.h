@@ -0,0 +1,376 @@
+/*
+  ==============================================================================
+
+    FusedPipeline.h
+    Created: 17 Oct 2026 1:47:10pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+/** Coefficients of a topology-preserving-transform state variable filter.
+    The maths matches juce::dsp::StateVariableTPTFilter, but the state lives
+    outside the filter so a per-sample loop can keep it in registers.
+*/
+template <typename SampleType>
+struct TPTCoefficients
+{
+    SampleType g = 0, R2 = 0, h = 1;
+
+    static TPTCoefficients make (double sampleRate, double cutoffHz, double resonance) noexcept
+    {
+        return fromWarpedCutoff (std::tan (juce::MathConstants<double>::pi * juce::jmin (cutoffHz, sampleRate * 0.49) / sampleRate), resonance);
+    }
+
+    /** From g = tan (pi * cutoff / sampleRate) already worked out, e.g. read from a table. */
+    static TPTCoefficients fromWarpedCutoff (double warpedCutoff, double resonance) noexcept
+    {
+        TPTCoefficients c;
+        c.g  = (SampleType) warpedCutoff;
+        c.R2 = (SampleType) (1.0 / resonance);
+        c.h  = (SampleType) 1 / ((SampleType) 1 + c.R2 * c.g + c.g * c.g);
+        return c;
+    }
+
+    /** Magnitude response of the high- or low-pass output, for drawing it. The TPT
+        SVF is the bilinear transform of the analogue prototype, so w is the
+        prewarped frequency relative to the cutoff.
+    */
+    double getMagnitude (double sampleRate, double frequencyHz, bool highPass) const noexcept
+    {
+        const auto w = std::tan (juce::MathConstants<double>::pi * juce::jmin (frequencyHz, sampleRate * 0.499) / sampleRate) / (double) g;
+        const auto lowPass = 1.0 / std::sqrt ((1.0 - w * w) * (1.0 - w * w) + (double) R2 * (double) R2 * w * w);
+        return highPass ? w * w * lowPass : lowPass;
+    }
+};
+
+template <typename SampleType>
+struct TPTState
+{
+    SampleType s1 = 0, s2 = 0;
+};
+
+/** One sample of the high-pass output. SampleType is float or double, or a
+    SIMDRegister of either to run one channel per lane.
+*/
+template <typename SampleType, typename CoefficientType>
+SampleType processTPTHighPass (SampleType x, const TPTCoefficients<CoefficientType>& c, SampleType& s1, SampleType& s2) noexcept
+{
+    const auto yHP = (x - s1 * (c.g + c.R2) - s2) * c.h;
+    const auto yBP = yHP * c.g + s1;
+    s1 = yHP * c.g + yBP;
+    const auto yLP = yBP * c.g + s2;
+    s2 = yBP * c.g + yLP;
+    return yHP;
+}
+
+template <typename SampleType, typename CoefficientType>
+SampleType processTPTLowPass (SampleType x, const TPTCoefficients<CoefficientType>& c, SampleType& s1, SampleType& s2) noexcept
+{
+    const auto yHP = (x - s1 * (c.g + c.R2) - s2) * c.h;
+    const auto yBP = yHP * c.g + s1;
+    s1 = yHP * c.g + yBP;
+    const auto yLP = yBP * c.g + s2;
+    s2 = yBP * c.g + yLP;
+    return yLP;
+}
+
+//==============================================================================
+/** The HPF and LPF are each up to this many sections in series, for slopes of
+    12, 24, 36 or 48 dB/oct.
+*/
+constexpr int maxTPTSections = 4;
+
+template <typename SampleType>
+struct TPTCascade
+{
+    std::array<TPTCoefficients<SampleType>, maxTPTSections> sections;
+    int numSections = 1;
+};
+
+template <typename SampleType>
+using TPTCascadeState = std::array<TPTState<SampleType>, maxTPTSections>;
+
+/** One section over a run of samples, in place. Running each section over the
+    whole run, rather than every section per sample, keeps the loop the same
+    whatever the slope while the state stays in registers.
+*/
+template <bool highPass, typename SampleType, typename CoefficientType>
+void processTPTSection (SampleType* data, int numSamples, const TPTCoefficients<CoefficientType>& c, TPTState<SampleType>& state) noexcept
+{
+    auto s1 = state.s1, s2 = state.s2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if constexpr (highPass)
+            data[i] = processTPTHighPass (data[i], c, s1, s2);
+        else
+            data[i] = processTPTLowPass (data[i], c, s1, s2);
+    }
+
+    state = { s1, s2 };
+}
+
+//==============================================================================
+/** Everything a chunk needs that is shared between channels: the drive, the
+    filter coefficient schedule and the mix coefficients, either as constants or
+    as per-sample ramps while a parameter is being smoothed.
+*/
+template <typename SampleType>
+struct PipelineBlock
+{
+    struct FilterCoefficients
+    {
+        TPTCascade<SampleType> highPass, lowPass;
+    };
+
+    int numSamples = 0;
+
+    const SampleType* driveRamp = nullptr;  // null while drive is steady
+    SampleType drive = 1;
+
+    const FilterCoefficients* coefficients = nullptr;
+    int coefficientInterval = 1;            // samples covered by each entry of coefficients
+
+    const SampleType* dryRamp = nullptr;    // both null while mix and gain are steady
+    const SampleType* wetRamp = nullptr;
+    SampleType dryGain = 1;
+    SampleType wetGain = 0;
+};
+
+/** Drive, HPF, LPF and the wet/dry mix for one channel in a single pass.
+
+    The channel is walked in short tiles: each tile is saturated with the shaper
+    (the SIMD kernel or a Waveshaper) into a stack buffer, run through each
+    filter section in turn, then mixed straight back into the channel. Audio is
+    read and written once, and the tile never leaves L1.
+*/
+template <bool rampedDrive, bool rampedMix, typename SampleType, typename Shaper>
+void processFusedChannel (const PipelineBlock<SampleType>& block, const Shaper& shaper,
+                          TPTCascadeState<SampleType>& highPass, TPTCascadeState<SampleType>& lowPass, SampleType* channelData) noexcept
+{
+    constexpr int tileSize = 32;
+    SampleType tile[tileSize];
+
+    for (int tileStart = 0; tileStart < block.numSamples; tileStart += tileSize)
+    {
+        const auto tileEnd = juce::jmin (tileStart + tileSize, block.numSamples);
+        const auto tileLength = tileEnd - tileStart;
+
+        if constexpr (rampedDrive)
+        {
+            juce::FloatVectorOperations::multiply (tile, channelData + tileStart, block.driveRamp + tileStart, tileLength);
+            shaper.process (tile, tile, tileLength, (SampleType) 1, (SampleType) 1);
+        }
+        else
+        {
+            shaper.process (channelData + tileStart, tile, tileLength, block.drive, (SampleType) 1);
+        }
+
+        for (int start = tileStart; start < tileEnd;)
+        {
+            const auto slot = start / block.coefficientInterval;
+            const auto end = juce::jmin (tileEnd, (slot + 1) * block.coefficientInterval);
+            const auto& coefficients = block.coefficients[slot];
+            auto* wet = tile + (start - tileStart);
+
+            for (int section = 0; section < coefficients.highPass.numSections; ++section)
+                processTPTSection<true> (wet, end - start, coefficients.highPass.sections[(size_t) section], highPass[(size_t) section]);
+
+            for (int section = 0; section < coefficients.lowPass.numSections; ++section)
+                processTPTSection<false> (wet, end - start, coefficients.lowPass.sections[(size_t) section], lowPass[(size_t) section]);
+
+            for (int i = start; i < end; ++i)
+            {
+                if constexpr (rampedMix)
+                    channelData[i] = channelData[i] * block.dryRamp[i] + tile[i - tileStart] * block.wetRamp[i];
+                else
+                    channelData[i] = channelData[i] * block.dryGain + tile[i - tileStart] * block.wetGain;
+            }
+
+            start = end;
+        }
+    }
+
+    for (auto* states : { &highPass, &lowPass })
+    {
+        for (auto& state : *states)
+        {
+            juce::dsp::util::snapToZero (state.s1);
+            juce::dsp::util::snapToZero (state.s2);
+        }
+    }
+}
+
+//==============================================================================
+/** Channels processed together by processFusedChannelGroup: in float 4 with SSE/NEON
+    and 8 with AVX, half that in double.
+*/
+template <typename SampleType>
+using ChannelLanes = juce::dsp::SIMDRegister<SampleType>;
+
+template <typename SampleType>
+constexpr int numChannelLanes = (int) ChannelLanes<SampleType>::size();
+
+/** The same single pass for numChannelLanes channels at once, one channel per SIMD lane.
+
+    Each tile is interleaved so that a sample frame of the group fills one
+    register. The shaper saturates the interleaved tile as one contiguous run,
+    then the filter sections and the mix step all lanes together, so the serial
+    filter recursion costs the same for the whole group as for a single channel.
+*/
+template <bool rampedDrive, bool rampedMix, typename SampleType, typename Shaper>
+void processFusedChannelGroup (const PipelineBlock<SampleType>& block, const Shaper& shaper,
+                               TPTCascadeState<SampleType>* highPass, TPTCascadeState<SampleType>* lowPass, SampleType* const* channelData) noexcept
+{
+    using Lanes = ChannelLanes<SampleType>;
+    constexpr int tileSize = 32;
+    constexpr auto lanes = numChannelLanes<SampleType>;
+
+    alignas (Lanes::SIMDRegisterSize) SampleType dryTile[tileSize * lanes];
+    alignas (Lanes::SIMDRegisterSize) SampleType wetTile[tileSize * lanes];
+    alignas (Lanes::SIMDRegisterSize) SampleType state[lanes];
+
+    // Filter state for every section, one channel per lane: high-pass s1 and s2, then low-pass s1 and s2
+    Lanes sectionState[4][maxTPTSections];
+
+    auto loadState = [&] (TPTCascadeState<SampleType>* states, int section, Lanes& s1, Lanes& s2)
+    {
+        for (int lane = 0; lane < lanes; ++lane)
+            state[lane] = states[lane][(size_t) section].s1;
+
+        s1 = Lanes::fromRawArray (state);
+
+        for (int lane = 0; lane < lanes; ++lane)
+            state[lane] = states[lane][(size_t) section].s2;
+
+        s2 = Lanes::fromRawArray (state);
+    };
+
+    auto storeState = [&] (TPTCascadeState<SampleType>* states, int section, Lanes s1, Lanes s2)
+    {
+        s1.copyToRawArray (state);
+
+        for (int lane = 0; lane < lanes; ++lane)
+            states[lane][(size_t) section].s1 = state[lane];
+
+        s2.copyToRawArray (state);
+
+        for (int lane = 0; lane < lanes; ++lane)
+            states[lane][(size_t) section].s2 = state[lane];
+    };
+
+    for (int section = 0; section < maxTPTSections; ++section)
+    {
+        loadState (highPass, section, sectionState[0][section], sectionState[1][section]);
+        loadState (lowPass, section, sectionState[2][section], sectionState[3][section]);
+    }
+
+    // One section over a run of interleaved frames, in place
+    auto processSection = [] (auto highPassTag, SampleType* frames, int numFrames, const TPTCoefficients<SampleType>& c, Lanes& s1, Lanes& s2)
+    {
+        auto z1 = s1, z2 = s2;
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            auto* frame = frames + i * lanes;
+
+            if constexpr (decltype (highPassTag)::value)
+                processTPTHighPass (Lanes::fromRawArray (frame), c, z1, z2).copyToRawArray (frame);
+            else
+                processTPTLowPass (Lanes::fromRawArray (frame), c, z1, z2).copyToRawArray (frame);
+        }
+
+        s1 = z1;
+        s2 = z2;
+    };
+
+    for (int tileStart = 0; tileStart < block.numSamples; tileStart += tileSize)
+    {
+        const auto tileEnd = juce::jmin (tileStart + tileSize, block.numSamples);
+        const auto tileLength = tileEnd - tileStart;
+
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const auto* source = channelData[lane] + tileStart;
+
+            for (int i = 0; i < tileLength; ++i)
+                dryTile[i * lanes + lane] = source[i];
+        }
+
+        if constexpr (rampedDrive)
+        {
+            for (int i = 0; i < tileLength; ++i)
+                for (int lane = 0; lane < lanes; ++lane)
+                    wetTile[i * lanes + lane] = dryTile[i * lanes + lane] * block.driveRamp[tileStart + i];
+
+            shaper.process (wetTile, wetTile, tileLength * lanes, (SampleType) 1, (SampleType) 1);
+        }
+        else
+        {
+            shaper.process (dryTile, wetTile, tileLength * lanes, block.drive, (SampleType) 1);
+        }
+
+        for (int start = tileStart; start < tileEnd;)
+        {
+            const auto slot = start / block.coefficientInterval;
+            const auto end = juce::jmin (tileEnd, (slot + 1) * block.coefficientInterval);
+            const auto& coefficients = block.coefficients[slot];
+            auto* frames = wetTile + (start - tileStart) * lanes;
+
+            for (int section = 0; section < coefficients.highPass.numSections; ++section)
+                processSection (std::true_type(), frames, end - start, coefficients.highPass.sections[(size_t) section],
+                                sectionState[0][section], sectionState[1][section]);
+
+            for (int section = 0; section < coefficients.lowPass.numSections; ++section)
+                processSection (std::false_type(), frames, end - start, coefficients.lowPass.sections[(size_t) section],
+                                sectionState[2][section], sectionState[3][section]);
+
+            for (int i = start; i < end; ++i)
+            {
+                auto* frame = wetTile + (i - tileStart) * lanes;
+                const auto dry = Lanes::fromRawArray (dryTile + (i - tileStart) * lanes);
+                const auto wet = Lanes::fromRawArray (frame);
+
+                if constexpr (rampedMix)
+                    (dry * block.dryRamp[i] + wet * block.wetRamp[i]).copyToRawArray (frame);
+                else
+                    (dry * block.dryGain + wet * block.wetGain).copyToRawArray (frame);
+            }
+
+            start = end;
+        }
+
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            auto* destination = channelData[lane] + tileStart;
+
+            for (int i = 0; i < tileLength; ++i)
+                destination[i] = wetTile[i * lanes + lane];
+        }
+    }
+
+    for (int section = 0; section < maxTPTSections; ++section)
+    {
+        storeState (highPass, section, sectionState[0][section], sectionState[1][section]);
+        storeState (lowPass, section, sectionState[2][section], sectionState[3][section]);
+    }
+
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        for (auto* states : { highPass + lane, lowPass + lane })
+        {
+            for (auto& sectionStateOfLane : *states)
+            {
+                juce::dsp::util::snapToZero (sectionStateOfLane.s1);
+                juce::dsp::util::snapToZero (sectionStateOfLane.s2);
+            }
+        }
+    }
+}
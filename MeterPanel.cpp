@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    MeterPanel.cpp
+    Created: 17 Oct 2026 8:10:37pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "MeterPanel.h"
+
+namespace
+{
+    const auto meterColour = juce::Colour::fromRGB (0, 255, 255);
+
+    constexpr float minimumDecibels = -60.0f;
+    constexpr float maximumDecibels = 6.0f;
+
+    // Per refresh: peaks fall about 20 dB/s, RMS and load settle over a few hundred ms
+    constexpr float peakFallPerTick = 0.926f;
+    constexpr float smoothing = 0.3f;
+
+    juce::String toKilobytes (size_t bytes)
+    {
+        return juce::String ((double) bytes / 1024.0, 0) + " KB";
+    }
+
+    float toProportion (float gain)
+    {
+        const auto decibels = juce::Decibels::gainToDecibels (gain, minimumDecibels);
+        return juce::jmap (juce::jlimit (minimumDecibels, maximumDecibels, decibels), minimumDecibels, maximumDecibels, 0.0f, 1.0f);
+    }
+}
+
+MeterPanel::MeterPanel (OverDrive4AudioProcessor& p)
+    : processor (p)
+{
+    processor.setTelemetryEnabled (true);
+    startTimerHz (refreshRateHz);
+}
+
+MeterPanel::~MeterPanel()
+{
+    stopTimer();
+    processor.setTelemetryEnabled (false);
+}
+
+void MeterPanel::timerCallback()
+{
+    // The same three stages, as they appear in each block and on screen
+    LevelReading BlockTelemetry::* const stages[] = { &BlockTelemetry::input, &BlockTelemetry::drive, &BlockTelemetry::output };
+    MeterState* const meters[] = { &input, &drive, &output };
+
+    float peaks[3] = {};
+    double sumOfSquares[3] = {}, totalLoad = 0.0;
+    float maximumLoad = 0.0f;
+    int totalSamples = 0;
+
+    processor.getTelemetryQueue().drain ([&] (const BlockTelemetry& t)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto& reading = t.*stages[i];
+            peaks[i] = juce::jmax (peaks[i], reading.peak);
+            sumOfSquares[i] += (double) reading.rms * reading.rms * t.numSamples;
+        }
+
+        totalLoad += (double) t.load * t.numSamples;
+        maximumLoad = juce::jmax (maximumLoad, t.load);
+        totalSamples += t.numSamples;
+    });
+
+    // With nothing queued (the host has stopped processing) everything falls away
+    const auto numSamples = (double) juce::jmax (1, totalSamples);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        meters[i]->peak = juce::jmax (peaks[i], meters[i]->peak * peakFallPerTick);
+        meters[i]->rms += smoothing * ((float) std::sqrt (sumOfSquares[i] / numSamples) - meters[i]->rms);
+    }
+
+    averageLoad += smoothing * ((float) (totalLoad / numSamples) - averageLoad);
+    peakLoad = juce::jmax (maximumLoad, peakLoad * peakFallPerTick);
+    worstFrameMilliseconds *= peakFallPerTick;
+
+    // Memory only changes on prepare or a preset save, so once a second is plenty
+    if (--ticksUntilMemoryReport <= 0)
+    {
+        memory = processor.getMemoryReport();
+        ticksUntilMemoryReport = refreshRateHz;
+    }
+
+    repaint();
+}
+
+void MeterPanel::setFrameTime (double averageMilliseconds, double lastMilliseconds) noexcept
+{
+    averageFrameMilliseconds = averageMilliseconds;
+    worstFrameMilliseconds = juce::jmax (worstFrameMilliseconds, lastMilliseconds);
+}
+
+void MeterPanel::paint (juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour (juce::Colours::black.withAlpha (0.25f));
+    g.fillRoundedRectangle (bounds, 6.0f);
+    g.setColour (juce::Colours::grey);
+    g.drawRoundedRectangle (bounds, 6.0f, 1.0f);
+
+    bounds.reduce (6.0f, 6.0f);
+
+    g.setColour (meterColour);
+    g.setFont (12.0f);
+    g.drawText ("UI " + juce::String (averageFrameMilliseconds, 2) + " ms  (worst " + juce::String (worstFrameMilliseconds, 2) + ")",
+                bounds.removeFromBottom (14.0f), juce::Justification::centred);
+    g.drawText ("Mem " + toKilobytes (memory.instanceBytes) + " + " + toKilobytes (memory.sharedBytes)
+                  + " shared by " + juce::String (memory.numInstances),
+                bounds.removeFromBottom (14.0f), juce::Justification::centred);
+    g.drawText ("CPU " + juce::String (averageLoad * 100.0f, 1) + "%  (peak " + juce::String (peakLoad * 100.0f, 1) + "%)",
+                bounds.removeFromBottom (14.0f), juce::Justification::centred);
+
+    const auto meterWidth = bounds.getWidth() / 3.0f;
+    drawMeter (g, bounds.removeFromLeft (meterWidth).reduced (6.0f, 0.0f), input, "In");
+    drawMeter (g, bounds.removeFromLeft (meterWidth).reduced (6.0f, 0.0f), drive, "Drive");
+    drawMeter (g, bounds.reduced (6.0f, 0.0f), output, "Out");
+}
+
+void MeterPanel::drawMeter (juce::Graphics& g, juce::Rectangle<float> area, const MeterState& meter, const juce::String& name) const
+{
+    g.setColour (meterColour);
+    g.setFont (12.0f);
+    g.drawText (name, area.removeFromBottom (14.0f), juce::Justification::centred);
+
+    g.setColour (juce::Colours::black.withAlpha (0.4f));
+    g.fillRect (area);
+
+    // RMS as the bar, peak as a line above it, red once past 0 dBFS
+    auto bar = area;
+    g.setColour (meterColour.withAlpha (0.7f));
+    g.fillRect (bar.removeFromBottom (area.getHeight() * toProportion (meter.rms)));
+
+    const auto peakY = area.getBottom() - area.getHeight() * toProportion (meter.peak);
+    g.setColour (meter.peak > 1.0f ? juce::Colours::red : meterColour);
+    g.drawHorizontalLine (juce::roundToInt (peakY), area.getX(), area.getRight());
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    MeterPanel.h
+    Created: 17 Oct 2026 8:10:37pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+/** Input, drive and output meters plus the CPU load, fed by the processor's
+    telemetry queue, and the instance's memory use. The queue is drained on a
+    timer, so the audio thread only ever pushes; telemetry is switched on for
+    as long as the panel exists.
+*/
+class MeterPanel : public juce::Component,
+                   private juce::Timer
+{
+public:
+    explicit MeterPanel (OverDrive4AudioProcessor&);
+    ~MeterPanel() override;
+
+    void paint (juce::Graphics&) override;
+
+    /** The editor's frame time, shown under the CPU load. */
+    void setFrameTime (double averageMilliseconds, double lastMilliseconds) noexcept;
+
+private:
+    void timerCallback() override;
+
+    struct MeterState
+    {
+        float peak = 0.0f;      // Falls back slowly after a peak, in gain
+        float rms = 0.0f;
+    };
+
+    void drawMeter (juce::Graphics&, juce::Rectangle<float> area, const MeterState&, const juce::String& name) const;
+
+    OverDrive4AudioProcessor& processor;
+
+    MeterState input, drive, output;
+    float averageLoad = 0.0f, peakLoad = 0.0f;
+    double averageFrameMilliseconds = 0.0, worstFrameMilliseconds = 0.0;
+
+    MemoryReport memory;
+    int ticksUntilMemoryReport = 0;
+
+    static constexpr int refreshRateHz = 30;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterPanel)
+};
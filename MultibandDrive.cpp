@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+    MultibandDrive.cpp
+    Created: 17 Oct 2026 11:41:09pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "MultibandDrive.h"
+
+namespace
+{
+    enum class SectionOutput
+    {
+        none,
+        lowPass,
+        highPass,
+        allPass,
+        through
+    };
+
+    struct SectionWiring
+    {
+        int crossover;
+        SectionOutput output;
+    };
+
+    constexpr auto LP = SectionOutput::lowPass;
+    constexpr auto HP = SectionOutput::highPass;
+    constexpr auto AP = SectionOutput::allPass;
+    constexpr auto through = SectionOutput::through;
+
+    // By number of bands (from 2), section and band: the crossover the section is tuned to and what it passes on
+    constexpr SectionWiring layouts[maxBands - 1][maxCrossoverSections][maxBands] =
+    {
+        {
+            { { 0, LP }, { 0, HP } },
+            { { 0, LP }, { 0, HP } },
+        },
+        {
+            { { 0, LP },      { 0, HP }, { 0, HP } },
+            { { 0, LP },      { 0, HP }, { 0, HP } },
+            { { 1, AP },      { 1, LP }, { 1, HP } },
+            { { 1, through }, { 1, LP }, { 1, HP } },
+        },
+        {
+            { { 1, LP }, { 1, LP }, { 1, HP }, { 1, HP } },
+            { { 1, LP }, { 1, LP }, { 1, HP }, { 1, HP } },
+            { { 0, LP }, { 0, HP }, { 2, LP }, { 2, HP } },
+            { { 0, LP }, { 0, HP }, { 2, LP }, { 2, HP } },
+            { { 2, AP }, { 2, AP }, { 0, AP }, { 0, AP } },
+        },
+    };
+
+    constexpr int numSectionsForLayout[maxBands - 1] = { 2, 4, 5 };
+
+    // Butterworth Q, so two sections in series make an LR4, and the LR4's allpass is one section
+    constexpr double crossoverR2 = 1.4142135623730951;
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandDrive<SampleType>::prepare (int numChannels, int maximumBlockSize, double sampleRate,
+                                          const CutoffTable& table, const MultibandSettings& settings)
+{
+    cutoffTable = &table;
+    state.resize ((size_t) numChannels);
+
+    const auto maxTiles = (size_t) (maximumBlockSize / tileSize + 1);
+    crossoverSchedule.resize (maxTiles);
+    tileSchedule.resize (maxTiles);
+
+    for (auto& smoothed : crossoverSmoothed)
+        smoothed.reset (sampleRate, 0.05);
+
+    for (auto* smoothers : { &driveSmoothed, &gainSmoothed, &mixSmoothed })
+        for (auto& smoothed : *smoothers)
+            smoothed.reset (sampleRate, 0.02);
+
+    numBands = 0;   // So setSettings lays the bands out again
+    setSettings (settings);
+
+    for (auto& smoothed : crossoverSmoothed)
+        smoothed.setCurrentAndTargetValue (smoothed.getTargetValue());
+
+    for (auto* smoothers : { &driveSmoothed, &gainSmoothed, &mixSmoothed })
+        for (auto& smoothed : *smoothers)
+            smoothed.setCurrentAndTargetValue (smoothed.getTargetValue());
+
+    steadyCrossoverValid = false;
+    reset();
+}
+
+template <typename SampleType>
+void MultibandDrive<SampleType>::reset() noexcept
+{
+    for (auto& channelState : state)
+        for (auto& groupState : channelState)
+            for (auto& sectionState : groupState)
+                sectionState = { Lanes::expand (0), Lanes::expand (0) };
+}
+
+template <typename SampleType>
+double MultibandDrive<SampleType>::getTailSeconds (const MultibandSettings& settings, double decayNepers) noexcept
+{
+    const auto bands = juce::jlimit (1, maxBands, settings.numBands);
+
+    if (bands < 2)
+        return 0.0;
+
+    // The lowest crossover rings longest; counting every section at it errs on the long side
+    auto lowestHz = settings.crossoverHz[0];
+
+    for (int i = 1; i < bands - 1; ++i)
+        lowestHz = juce::jmin (lowestHz, settings.crossoverHz[(size_t) i]);
+
+    const auto zeta = crossoverR2 / 2.0;
+    const auto decayRate = zeta * juce::MathConstants<double>::twoPi * juce::jmax (20.0, (double) lowestHz);
+    return numSectionsForLayout[bands - 2] * decayNepers / decayRate;
+}
+
+template <typename SampleType>
+void MultibandDrive<SampleType>::setSettings (const MultibandSettings& settings) noexcept
+{
+    const auto newNumBands = juce::jlimit (1, maxBands, settings.numBands);
+
+    if (newNumBands != numBands)
+    {
+        // A different layout, so the old section state means nothing to it
+        numBands = newNumBands;
+        numGroups = (numBands + lanes - 1) / lanes;
+        numSections = numBands > 1 ? numSectionsForLayout[numBands - 2] : 0;
+        steadyCrossoverValid = false;
+        reset();
+    }
+
+    // Kept in order, so each band stays between its neighbours
+    auto crossovers = settings.crossoverHz;
+
+    for (size_t i = 1; i < (size_t) juce::jmax (1, numBands - 1); ++i)
+        for (auto j = i; j > 0 && crossovers[j] < crossovers[j - 1]; --j)
+            std::swap (crossovers[j], crossovers[j - 1]);
+
+    for (size_t i = 0; i < crossovers.size(); ++i)
+        crossoverSmoothed[i].setTargetValue (CutoffTable::getPosition (crossovers[i]));
+
+    for (size_t band = 0; band < (size_t) maxBands; ++band)
+    {
+        driveSmoothed[band].setTargetValue (settings.drive[band]);
+        gainSmoothed[band].setTargetValue (juce::Decibels::decibelsToGain (settings.gainDecibels[band]));
+        mixSmoothed[band].setTargetValue (settings.mixPercent[band] / 100.0f);
+    }
+}
+
+template <typename SampleType>
+bool MultibandDrive<SampleType>::isSmoothing() const noexcept
+{
+    for (const auto* smoothers : { &driveSmoothed, &gainSmoothed, &mixSmoothed })
+        for (const auto& smoothed : *smoothers)
+            if (smoothed.isSmoothing())
+                return true;
+
+    for (const auto& smoothed : crossoverSmoothed)
+        if (smoothed.isSmoothing())
+            return true;
+
+    return false;
+}
+
+template <typename SampleType>
+bool MultibandDrive<SampleType>::hasDecayed (SampleType threshold) const noexcept
+{
+    if (! isEnabled())
+        return true;
+
+    if (isSmoothing())
+        return false;
+
+    alignas (Lanes::SIMDRegisterSize) SampleType values[lanes];
+
+    for (const auto& channelState : state)
+    {
+        for (const auto& groupState : channelState)
+        {
+            for (const auto& sectionState : groupState)
+            {
+                for (const auto* lanesState : { &sectionState.s1, &sectionState.s2 })
+                {
+                    lanesState->copyToRawArray (values);
+
+                    for (auto value : values)
+                        if (std::abs (value) > threshold)
+                            return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+template <typename SampleType>
+typename MultibandDrive<SampleType>::Crossover MultibandDrive<SampleType>::makeCrossover (const std::array<float, maxBands - 1>& positions) const noexcept
+{
+    std::array<double, maxBands - 1> warpedCutoffs;
+
+    for (size_t i = 0; i < positions.size(); ++i)
+        warpedCutoffs[i] = cutoffTable->getWarpedCutoff (positions[i]);
+
+    alignas (Lanes::SIMDRegisterSize) SampleType g[lanes], gPlusR2[lanes], h[lanes], highPass[lanes], bandPass[lanes], lowPass[lanes];
+    Crossover crossover;
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        for (int section = 0; section < numSections; ++section)
+        {
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const auto band = group * lanes + lane;
+                const auto wiring = band < numBands ? layouts[numBands - 2][section][band] : SectionWiring { 0, SectionOutput::none };
+                const auto coefficients = TPTCoefficients<SampleType>::fromWarpedCutoff (warpedCutoffs[(size_t) wiring.crossover], 1.0 / crossoverR2);
+
+                g[lane] = coefficients.g;
+                gPlusR2[lane] = coefficients.g + coefficients.R2;
+                h[lane] = coefficients.h;
+
+                // The section's input is exactly highPass + R2 * bandPass + lowPass, and the allpass flips the band-pass part
+                const auto r2 = coefficients.R2;
+
+                switch (wiring.output)
+                {
+                    case SectionOutput::lowPass:    highPass[lane] = 0; bandPass[lane] = 0;   lowPass[lane] = 1; break;
+                    case SectionOutput::highPass:   highPass[lane] = 1; bandPass[lane] = 0;   lowPass[lane] = 0; break;
+                    case SectionOutput::allPass:    highPass[lane] = 1; bandPass[lane] = -r2; lowPass[lane] = 1; break;
+                    case SectionOutput::through:    highPass[lane] = 1; bandPass[lane] = r2;  lowPass[lane] = 1; break;
+                    case SectionOutput::none:
+                    default:                        highPass[lane] = 0; bandPass[lane] = 0;   lowPass[lane] = 0; break;
+                }
+            }
+
+            crossover[(size_t) group][(size_t) section] = { Lanes::fromRawArray (g), Lanes::fromRawArray (gPlusR2), Lanes::fromRawArray (h),
+                                                            Lanes::fromRawArray (highPass), Lanes::fromRawArray (bandPass), Lanes::fromRawArray (lowPass) };
+        }
+    }
+
+    return crossover;
+}
+
+template <typename SampleType>
+void MultibandDrive<SampleType>::prepareSchedule (int numSamples) noexcept
+{
+    const auto crossoversMoving = std::any_of (crossoverSmoothed.begin(), crossoverSmoothed.end(),
+                                               [] (const auto& smoothed) { return smoothed.isSmoothing(); });
+
+    if (! crossoversMoving && ! steadyCrossoverValid)
+    {
+        std::array<float, maxBands - 1> positions;
+
+        for (size_t i = 0; i < positions.size(); ++i)
+            positions[i] = crossoverSmoothed[i].getTargetValue();
+
+        steadyCrossover = makeCrossover (positions);
+        steadyCrossoverValid = true;
+    }
+
+    alignas (Lanes::SIMDRegisterSize) SampleType values[6][maxGroups * lanes] = {};
+
+    for (int tileStart = 0, tile = 0; tileStart < numSamples; tileStart += tileSize, ++tile)
+    {
+        const auto tileLength = juce::jmin (tileSize, numSamples - tileStart);
+        auto& controls = tileSchedule[(size_t) tile];
+
+        // While a crossover moves, its coefficients follow once per tile
+        if (crossoversMoving)
+        {
+            std::array<float, maxBands - 1> positions;
+
+            for (size_t i = 0; i < positions.size(); ++i)
+                positions[i] = crossoverSmoothed[i].skip (tileLength);
+
+            crossoverSchedule[(size_t) tile] = makeCrossover (positions);
+            controls.crossover = &crossoverSchedule[(size_t) tile];
+            steadyCrossover = crossoverSchedule[(size_t) tile];
+        }
+        else
+        {
+            controls.crossover = &steadyCrossover;
+        }
+
+        // Start and per-sample step of each band's drive, dry gain and wet gain (mix times gain)
+        for (int band = 0; band < numBands; ++band)
+        {
+            auto& drive = driveSmoothed[(size_t) band];
+            auto& gain = gainSmoothed[(size_t) band];
+            auto& mix = mixSmoothed[(size_t) band];
+
+            const auto driveStart = drive.getCurrentValue();
+            const auto mixStart = mix.getCurrentValue();
+            const auto wetStart = mixStart * gain.getCurrentValue();
+            const auto driveEnd = drive.skip (tileLength);
+            const auto mixEnd = mix.skip (tileLength);
+            const auto wetEnd = mixEnd * gain.skip (tileLength);
+
+            values[0][band] = (SampleType) driveStart;
+            values[1][band] = (SampleType) ((driveEnd - driveStart) / (float) tileLength);
+            values[2][band] = (SampleType) (1.0f - mixStart);
+            values[3][band] = (SampleType) ((mixStart - mixEnd) / (float) tileLength);
+            values[4][band] = (SampleType) wetStart;
+            values[5][band] = (SampleType) ((wetEnd - wetStart) / (float) tileLength);
+        }
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            const auto offset = group * lanes;
+            controls.drive[(size_t) group]     = Lanes::fromRawArray (values[0] + offset);
+            controls.driveStep[(size_t) group] = Lanes::fromRawArray (values[1] + offset);
+            controls.dryGain[(size_t) group]   = Lanes::fromRawArray (values[2] + offset);
+            controls.dryStep[(size_t) group]   = Lanes::fromRawArray (values[3] + offset);
+            controls.wetGain[(size_t) group]   = Lanes::fromRawArray (values[4] + offset);
+            controls.wetStep[(size_t) group]   = Lanes::fromRawArray (values[5] + offset);
+        }
+    }
+}
+
+//==============================================================================
+template class MultibandDrive<float>;
+template class MultibandDrive<double>;
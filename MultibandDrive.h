@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    MultibandDrive.h
+    Created: 17 Oct 2026 11:41:09pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "FusedPipeline.h"
+#include "FilterSlopes.h"
+
+/*  Multiband drive: the input is split into 2 to 4 bands by 24 dB/oct
+    Linkwitz-Riley crossovers, and each band is driven, gained and mixed on its
+    own before they are summed again.
+
+    The bands run side by side, one per SIMD lane, rather than one after
+    another. Every lane goes through the same chain of TPT SVF sections (at
+    Q 0.7071, two make an LR4 high- or low-pass); only the cutoff and which of
+    the section's outputs is passed on differ per lane. So one pass through the
+    chain splits a sample into all the bands:
+
+        2 bands     LR4 at crossover 1
+        3 bands     LR4 at crossover 1, then at crossover 2 for the upper bands
+                    while the low band gets crossover 2's allpass
+        4 bands     LR4 at crossover 2, then at 1 or 3, then the allpass of 3 or 1
+
+    Each band also gets the allpass of every crossover it wasn't split at, so
+    the bands always sum to the input through one allpass. That sum is the dry
+    signal for the main mix, so mixing stays phase-coherent at any setting.
+*/
+constexpr int maxBands = 4;
+constexpr int maxCrossoverSections = 5;
+
+struct MultibandSettings
+{
+    int numBands = 1;       // 1 = off, and the main Drive applies
+    std::array<float, maxBands - 1> crossoverHz { 150.0f, 1000.0f, 5000.0f };
+    std::array<float, maxBands> drive { 5.0f, 5.0f, 5.0f, 5.0f };
+    std::array<float, maxBands> gainDecibels {};
+    std::array<float, maxBands> mixPercent { 100.0f, 100.0f, 100.0f, 100.0f };
+};
+
+//==============================================================================
+template <typename SampleType>
+class MultibandDrive
+{
+public:
+    using Lanes = ChannelLanes<SampleType>;
+    static constexpr int lanes = numChannelLanes<SampleType>;
+    static constexpr int maxGroups = (maxBands + lanes - 1) / lanes;     // Registers needed to hold every band
+    static constexpr int tileSize = 32;
+
+    /** Allocates the filter state and schedules. The cutoff table is the DSP's,
+        and has to outlive this.
+    */
+    void prepare (int numChannels, int maximumBlockSize, double sampleRate, const CutoffTable& table, const MultibandSettings& settings);
+    void reset() noexcept;
+
+    bool isEnabled() const noexcept             { return numBands > 1; }
+
+    /** Lanes that carry no band but still go through the shaper, per sample and channel. */
+    int getNumPaddingLanes() const noexcept     { return numGroups * lanes - numBands; }
+
+    void setSettings (const MultibandSettings& settings) noexcept;
+
+    /** Works out the crossover coefficients and band gains for each tile of the
+        next numSamples. Called once per chunk; every channel then shares them.
+    */
+    void prepareSchedule (int numSamples) noexcept;
+
+    bool hasDecayed (SampleType threshold) const noexcept;
+
+    /** How long the crossovers take to ring down by decayNepers with these
+        settings: every section in the layout, at the lowest crossover.
+    */
+    static double getTailSeconds (const MultibandSettings& settings, double decayNepers) noexcept;
+
+    size_t getMemoryUsage() const noexcept
+    {
+        return state.capacity() * sizeof (ChannelState)
+             + crossoverSchedule.capacity() * sizeof (Crossover)
+             + tileSchedule.capacity() * sizeof (TileControls);
+    }
+
+    /** Splits one channel into bands, drives and mixes each one, and sums them again.
+
+        data holds the input, and gets back the bands summed without drive (the
+        input through the crossovers' allpass). wet gets the sum of the bands'
+        own wet/dry mixes.
+    */
+    template <typename Shaper>
+    void process (const Shaper& shaper, int channel, SampleType* data, SampleType* wet, int numSamples) noexcept;
+
+private:
+    // One SVF section per lane, and the mix of its outputs passed on: low-pass, high-pass, allpass, through or nothing
+    struct Section
+    {
+        Lanes g, gPlusR2, h, highPassGain, bandPassGain, lowPassGain;
+    };
+
+    using Crossover = std::array<std::array<Section, maxCrossoverSections>, maxGroups>;
+
+    // The band gains as per-sample linear ramps across one tile
+    struct TileControls
+    {
+        const Crossover* crossover = nullptr;
+        std::array<Lanes, maxGroups> drive, driveStep, dryGain, dryStep, wetGain, wetStep;
+    };
+
+    struct SectionState
+    {
+        Lanes s1, s2;
+    };
+
+    using ChannelState = std::array<std::array<SectionState, maxCrossoverSections>, maxGroups>;
+
+    Crossover makeCrossover (const std::array<float, maxBands - 1>& positions) const noexcept;
+    bool isSmoothing() const noexcept;
+
+    const CutoffTable* cutoffTable = nullptr;
+    int numBands = 1, numGroups = 1, numSections = 0;
+
+    // Crossovers are smoothed as positions in the cutoff table, like the HPF and LPF
+    std::array<juce::SmoothedValue<float>, maxBands - 1> crossoverSmoothed;
+    std::array<juce::SmoothedValue<float>, maxBands> driveSmoothed, gainSmoothed, mixSmoothed;
+
+    std::vector<ChannelState> state;
+    std::vector<Crossover> crossoverSchedule;
+    std::vector<TileControls> tileSchedule;
+    Crossover steadyCrossover;
+    bool steadyCrossoverValid = false;
+};
+
+//==============================================================================
+template <typename SampleType>
+template <typename Shaper>
+void MultibandDrive<SampleType>::process (const Shaper& shaper, int channel, SampleType* data, SampleType* wet, int numSamples) noexcept
+{
+    alignas (Lanes::SIMDRegisterSize) SampleType bandTile[tileSize * lanes];
+    alignas (Lanes::SIMDRegisterSize) SampleType shapedTile[tileSize * lanes];
+    SampleType dryTile[tileSize];
+
+    auto& channelState = state[(size_t) channel];
+
+    for (int tileStart = 0, tile = 0; tileStart < numSamples; tileStart += tileSize, ++tile)
+    {
+        const auto tileLength = juce::jmin (tileSize, numSamples - tileStart);
+        const auto& controls = tileSchedule[(size_t) tile];
+        const auto* input = data + tileStart;
+        auto* output = wet + tileStart;
+
+        std::fill (dryTile, dryTile + tileLength, (SampleType) 0);
+        std::fill (output, output + tileLength, (SampleType) 0);
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            const auto& sections = (*controls.crossover)[(size_t) group];
+            auto z = channelState[(size_t) group];      // Kept in registers for the tile
+            auto drive = controls.drive[(size_t) group];
+
+            // Every lane runs the same sections, so this splits off all the group's bands at once
+            for (int i = 0; i < tileLength; ++i)
+            {
+                auto x = Lanes::expand (input[i]);
+
+                for (int section = 0; section < numSections; ++section)
+                {
+                    const auto& c = sections[(size_t) section];
+                    auto& s = z[(size_t) section];
+
+                    const auto yHP = (x - s.s1 * c.gPlusR2 - s.s2) * c.h;
+                    const auto yBP = yHP * c.g + s.s1;
+                    s.s1 = yHP * c.g + yBP;
+                    const auto yLP = yBP * c.g + s.s2;
+                    s.s2 = yBP * c.g + yLP;
+                    x = yHP * c.highPassGain + yBP * c.bandPassGain + yLP * c.lowPassGain;
+                }
+
+                x.copyToRawArray (bandTile + i * lanes);
+                (x * drive).copyToRawArray (shapedTile + i * lanes);
+                dryTile[i] += x.sum();
+                drive = drive + controls.driveStep[(size_t) group];
+            }
+
+            channelState[(size_t) group] = z;
+
+            // The bands' drives are already applied, so the shaper sees one contiguous run
+            shaper.process (shapedTile, shapedTile, tileLength * lanes, (SampleType) 1, (SampleType) 1);
+
+            auto dryGain = controls.dryGain[(size_t) group];
+            auto wetGain = controls.wetGain[(size_t) group];
+
+            for (int i = 0; i < tileLength; ++i)
+            {
+                const auto band = Lanes::fromRawArray (bandTile + i * lanes);
+                const auto shaped = Lanes::fromRawArray (shapedTile + i * lanes);
+                output[i] += (band * dryGain + shaped * wetGain).sum();
+
+                dryGain = dryGain + controls.dryStep[(size_t) group];
+                wetGain = wetGain + controls.wetStep[(size_t) group];
+            }
+        }
+
+        std::copy (dryTile, dryTile + tileLength, data + tileStart);
+    }
+}
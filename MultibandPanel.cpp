@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    MultibandPanel.cpp
+    Created: 17 Oct 2026 11:58:22pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "MultibandPanel.h"
+
+namespace
+{
+    const char* const bandNames[maxBands] = { "Low", "Low Mid", "High Mid", "High" };
+
+    void setUpKnob (juce::Slider& knob, const juce::String& tooltip, const juce::String& suffix)
+    {
+        knob.setSliderStyle (juce::Slider::RotaryHorizontalVerticalDrag);
+        knob.setTextBoxStyle (juce::Slider::NoTextBox, false, 0, 0);
+        knob.setPopupDisplayEnabled (true, true, nullptr);
+        knob.setTextValueSuffix (suffix);
+        knob.setTooltip (tooltip);
+    }
+}
+
+MultibandPanel::MultibandPanel (OverDrive4AudioProcessor& p)
+    : processor (p)
+{
+    bandsLabel.setText ("Bands", juce::dontSendNotification);
+    bandsLabel.setJustificationType (juce::Justification::centredLeft);
+    addAndMakeVisible (bandsLabel);
+
+    bandsBox.addItemList (p.parameters.getParameter ("BANDS")->getAllValueStrings(), 1);
+    bandsBox.onChange = [this] { updateEnabledBands(); };
+    addAndMakeVisible (bandsBox);
+
+    bandsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (processor.parameters, "BANDS", bandsBox);
+
+    for (int band = 0; band < maxBands; ++band)
+    {
+        auto& controls = bands[(size_t) band];
+        const auto id = "BAND" + juce::String (band + 1) + "_";
+
+        controls.label.setText (bandNames[band], juce::dontSendNotification);
+        controls.label.setJustificationType (juce::Justification::centred);
+        addAndMakeVisible (controls.label);
+
+        setUpKnob (controls.drive, "Drive", {});
+        setUpKnob (controls.gain, "Gain", " dB");
+        setUpKnob (controls.mix, "Mix", " %");
+
+        for (auto* knob : { &controls.drive, &controls.gain, &controls.mix })
+            addAndMakeVisible (*knob);
+
+        controls.driveAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (processor.parameters, id + "DRIVE", controls.drive);
+        controls.gainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (processor.parameters, id + "GAIN", controls.gain);
+        controls.mixAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (processor.parameters, id + "MIX", controls.mix);
+    }
+
+    updateEnabledBands();
+}
+
+void MultibandPanel::updateEnabledBands()
+{
+    // "Off" is one band: the main Drive knob
+    const auto numBands = bandsBox.getSelectedItemIndex() + 1;
+
+    for (int band = 0; band < maxBands; ++band)
+    {
+        auto& controls = bands[(size_t) band];
+        const auto enabled = numBands > 1 && band < numBands;
+
+        juce::Component* components[] = { &controls.label, &controls.drive, &controls.gain, &controls.mix };
+
+        for (auto* component : components)
+        {
+            component->setEnabled (enabled);
+            component->setAlpha (enabled ? 1.0f : 0.35f);
+        }
+    }
+}
+
+void MultibandPanel::paint (juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour (juce::Colours::black.withAlpha (0.25f));
+    g.fillRoundedRectangle (bounds, 6.0f);
+    g.setColour (juce::Colours::grey);
+    g.drawRoundedRectangle (bounds, 6.0f, 1.0f);
+}
+
+void MultibandPanel::resized()
+{
+    auto bounds = getLocalBounds().reduced (6);
+
+    auto selector = bounds.removeFromLeft (90);
+    bandsLabel.setBounds (selector.removeFromTop (20));
+    bandsBox.setBounds (selector.removeFromTop (24));
+    bounds.removeFromLeft (6);
+
+    const auto columnWidth = bounds.getWidth() / maxBands;
+
+    for (auto& controls : bands)
+    {
+        auto column = bounds.removeFromLeft (columnWidth).reduced (2, 0);
+        controls.label.setBounds (column.removeFromTop (16));
+
+        const auto knobWidth = column.getWidth() / 3;
+
+        for (auto* knob : { &controls.drive, &controls.gain, &controls.mix })
+            knob->setBounds (column.removeFromLeft (knobWidth));
+    }
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    MultibandPanel.h
+    Created: 17 Oct 2026 11:58:22pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+/** Band count plus drive, gain and mix knobs for each band. Bands past the
+    current count are greyed out. The crossovers are dragged on the spectrum view.
+*/
+class MultibandPanel : public juce::Component
+{
+public:
+    explicit MultibandPanel (OverDrive4AudioProcessor&);
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    struct BandControls
+    {
+        juce::Label label;
+        juce::Slider drive, gain, mix;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> driveAttachment, gainAttachment, mixAttachment;
+    };
+
+    void updateEnabledBands();
+
+    OverDrive4AudioProcessor& processor;
+
+    juce::Label bandsLabel;
+    juce::ComboBox bandsBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> bandsAttachment;
+
+    std::array<BandControls, maxBands> bands;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultibandPanel)
+};
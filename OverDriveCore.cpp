@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+
+    OverDriveCore.cpp
+    Created: 18 Oct 2026 1:04:37am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "OverDriveCore.h"
+#include "AudioThreadAllocationTrap.h"
+
+OverDriveCore::OverDriveCore()
+{
+    for (int i = 0; i < PresetParameters::numParameters; ++i)
+        parameterValues[(size_t) i].store (PresetParameters::defaults[i]);
+
+    curves.push_back (std::make_unique<UserCurve>());
+    userCurve = curves.back().get();
+}
+
+OverDriveCore::~OverDriveCore() = default;
+
+//==============================================================================
+void OverDriveCore::prepare (double newSampleRate, int maximumBlockSize, int newNumChannels, bool useDoublePrecision)
+{
+    prepare (newSampleRate, maximumBlockSize, newNumChannels, useDoublePrecision, getSettings());
+}
+
+void OverDriveCore::prepare (double newSampleRate, int maximumBlockSize, int newNumChannels, bool useDoublePrecision,
+                             const OverDriveSettings& settings)
+{
+    jassert (newSampleRate > 0.0 && maximumBlockSize > 0 && juce::isPositiveAndNotGreaterThan (newNumChannels, maxChannels));
+    newNumChannels = juce::jlimit (1, maxChannels, newNumChannels);
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = newSampleRate;
+    spec.maximumBlockSize = (juce::uint32) maximumBlockSize;
+    spec.numChannels = (juce::uint32) newNumChannels;
+
+    const juce::ScopedLock setup (setupLock);
+
+    auto table = sharedResources->getCutoffTable (newSampleRate);
+    auto clipperTable = sharedResources->getDiodeClipperTable (newSampleRate);
+
+    // The new DSP is built and prepared off to the side, so process only ever waits for the swap
+    std::unique_ptr<OverDriveDSP<float>> newFloatDSP;
+    std::unique_ptr<OverDriveDSP<double>> newDoubleDSP;
+
+    if (useDoublePrecision)
+    {
+        newDoubleDSP = std::make_unique<OverDriveDSP<double>>();
+        newDoubleDSP->prepare (spec, getEffectiveSettings (settings), std::move (table), std::move (clipperTable));
+    }
+    else
+    {
+        newFloatDSP = std::make_unique<OverDriveDSP<float>>();
+        newFloatDSP->prepare (spec, getEffectiveSettings (settings), std::move (table), std::move (clipperTable));
+    }
+
+    {
+        const juce::ScopedLock sl (processLock);
+        std::swap (floatDSP, newFloatDSP);
+        std::swap (doubleDSP, newDoubleDSP);
+        sampleRate = newSampleRate;
+        numChannels = newNumChannels;
+        useDouble = useDoublePrecision;
+    }
+
+    // The old DSP is freed here, outside the lock
+    newFloatDSP.reset();
+    newDoubleDSP.reset();
+
+    update (settings);
+}
+
+void OverDriveCore::release()
+{
+    const juce::ScopedLock setup (setupLock);
+
+    std::unique_ptr<OverDriveDSP<float>> oldFloatDSP;
+    std::unique_ptr<OverDriveDSP<double>> oldDoubleDSP;
+
+    {
+        const juce::ScopedLock sl (processLock);
+        std::swap (floatDSP, oldFloatDSP);
+        std::swap (doubleDSP, oldDoubleDSP);
+        sampleRate = 0.0;
+        numChannels = 0;
+        latencySamples = 0;
+    }
+
+    // Freed on leaving, outside the lock
+}
+
+void OverDriveCore::reset() noexcept
+{
+    const juce::ScopedLock sl (processLock);
+
+    if (floatDSP != nullptr)
+        floatDSP->reset();
+
+    if (doubleDSP != nullptr)
+        doubleDSP->reset();
+}
+
+//==============================================================================
+void OverDriveCore::setParameter (int index, float plainValue) noexcept
+{
+    if (juce::isPositiveAndBelow (index, (int) PresetParameters::numParameters))
+        parameterValues[(size_t) index].store (PresetParameters::constrain (index, plainValue), std::memory_order_relaxed);
+}
+
+float OverDriveCore::getParameter (int index) const noexcept
+{
+    return juce::isPositiveAndBelow (index, (int) PresetParameters::numParameters) ? parameterValues[(size_t) index].load (std::memory_order_relaxed)
+                                                                                    : 0.0f;
+}
+
+void OverDriveCore::setParameterValues (const ParameterValues& values) noexcept
+{
+    for (int i = 0; i < PresetParameters::numParameters; ++i)
+        setParameter (i, values[(size_t) i]);
+}
+
+ParameterValues OverDriveCore::getParameterValues() const noexcept
+{
+    ParameterValues values;
+
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = parameterValues[i].load (std::memory_order_relaxed);
+
+    return values;
+}
+
+void OverDriveCore::setUserCurve (const UserCurve& newCurve)
+{
+    auto curve = std::make_unique<UserCurve> (newCurve);
+    curve->points[UserCurve::numPoints / 2] = 0.0f;
+
+    const juce::ScopedLock sl (curveLock);
+    userCurve = curve.get();
+    curves.push_back (std::move (curve));
+
+    // Free the replaced curves process isn't using. Anything it picks up from
+    // here on is the new one: it checks the curve it marked is still current.
+    const auto* current = userCurve.load();
+    const auto* inUse = curveInUse.load();
+
+    curves.erase (std::remove_if (curves.begin(), curves.end(), [&] (const auto& c) { return c.get() != current && c.get() != inUse; }),
+                  curves.end());
+}
+
+UserCurve OverDriveCore::getUserCurve() const
+{
+    const juce::ScopedLock sl (curveLock);
+    return *userCurve.load();
+}
+
+OverDriveSettings OverDriveCore::getEffectiveSettings (const OverDriveSettings& settings) const noexcept
+{
+    auto effective = settings;
+
+    if (renderingOffline.load (std::memory_order_relaxed) && settings.renderTierOffline && settings.quality != QualityTier::custom)
+        applyQualityTier (effective, QualityTier::render);
+
+    return effective;
+}
+
+//==============================================================================
+bool OverDriveCore::process (float* const* channels, int numChannelsToProcess, int numSamples) noexcept
+{
+    return processChannels (channels, numChannelsToProcess, numSamples);
+}
+
+bool OverDriveCore::process (double* const* channels, int numChannelsToProcess, int numSamples) noexcept
+{
+    return processChannels (channels, numChannelsToProcess, numSamples);
+}
+
+template <typename SampleType>
+bool OverDriveCore::processChannels (SampleType* const* channels, int numChannelsToProcess, int numSamples) noexcept
+{
+    // The plugin wraps process in processBlock spans of its own; other hosts come in here
+    OVERDRIVE_TRACE_SPAN (traceBuffer, "process");
+
+    numChannelsToProcess = juce::jmin (numChannelsToProcess, numChannels.load());
+
+    if (numChannelsToProcess <= 0 || numSamples <= 0)
+        return true;
+
+    // Refers to the caller's channels rather than copying them, and with no more than maxChannels doesn't allocate
+    juce::AudioBuffer<SampleType> buffer (channels, numChannelsToProcess, numSamples);
+    return process (buffer, numChannelsToProcess, getSettings(), nullptr);
+}
+
+template <typename SampleType>
+bool OverDriveCore::process (juce::AudioBuffer<SampleType>& buffer, int numChannelsToProcess, const OverDriveSettings& requestedSettings, const UserCurve* curve) noexcept
+{
+    const auto settings = getEffectiveSettings (requestedSettings);
+
+    juce::ScopedNoDenormals noDenormals;
+    ScopedAudioThreadAllocationTrap allocationTrap;
+
+    // Only held elsewhere for a swap. Rather than wait for one, the block is left as it was, like a silent one.
+    const juce::ScopedTryLock sl (processLock);
+
+    if (! sl.isLocked())
+        return false;
+
+    auto* dspPointer = getDSP<SampleType>().get();
+
+    // Processing in the precision that wasn't prepared would be a caller bug
+    jassert (dspPointer != nullptr);
+
+    if (dspPointer == nullptr)
+        return true;
+
+    auto& dsp = *dspPointer;
+
+    if (curve == nullptr)
+    {
+        // Mark the curve before using it, and make sure it wasn't replaced (and maybe freed) in between
+        do
+        {
+            curve = userCurve.load();
+            curveInUse.store (curve);
+        }
+        while (curve != userCurve.load());
+    }
+
+    dsp.setUserCurve (curve);
+
+    // A different oversampling mode needs a new stage, which allocates, so it waits for update()
+    if (settings.oversamplingIndex != activeOversamplingIndex
+         || settings.linearPhaseOversampling != activeOversamplingLinearPhase)
+        updateNeeded.store (true, std::memory_order_relaxed);
+
+    if (dsp.process (buffer, numChannelsToProcess, settings, pipeline.load()))
+        return true;
+
+    skippedBlocks.fetch_add (1, std::memory_order_relaxed);
+    return false;
+}
+
+//==============================================================================
+bool OverDriveCore::needsUpdate (const OverDriveSettings& settings) const noexcept
+{
+    const auto effective = getEffectiveSettings (settings);
+    return effective.oversamplingIndex != activeOversamplingIndex
+        || effective.linearPhaseOversampling != activeOversamplingLinearPhase;
+}
+
+int OverDriveCore::update (const OverDriveSettings& requestedSettings)
+{
+    const juce::ScopedLock setup (setupLock);
+
+    const auto settings = getEffectiveSettings (requestedSettings);
+    updateNeeded = false;
+
+    if (doubleDSP != nullptr)
+        latencySamples = rebuildOversampling (*doubleDSP, settings);
+    else if (floatDSP != nullptr)
+        latencySamples = rebuildOversampling (*floatDSP, settings);
+
+    return latencySamples.load();
+}
+
+template <typename SampleType>
+std::unique_ptr<OverDriveDSP<SampleType>>& OverDriveCore::getDSP() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return doubleDSP;
+    else
+        return floatDSP;
+}
+
+template <typename SampleType>
+int OverDriveCore::rebuildOversampling (OverDriveDSP<SampleType>& dsp, const OverDriveSettings& settings)
+{
+    // Everything is built here, then swapped in under the lock
+    std::unique_ptr<typename OverDriveDSP<SampleType>::OversamplingStage> newStage;
+
+    if (settings.oversamplingIndex > 0 && dsp.isPrepared())
+    {
+        // The diode clipper runs inside the stage, at its rate
+        const auto oversampledRate = dsp.getSpec().sampleRate * (double) (1 << settings.oversamplingIndex);
+        newStage = std::make_unique<typename OverDriveDSP<SampleType>::OversamplingStage> (dsp.getSpec(), settings.oversamplingIndex,
+                                                                                          settings.linearPhaseOversampling,
+                                                                                          sharedResources->getDiodeClipperTable (oversampledRate));
+    }
+
+    {
+        const juce::ScopedLock sl (processLock);
+        dsp.swapOversampling (newStage);
+        activeOversamplingIndex = settings.oversamplingIndex;
+        activeOversamplingLinearPhase = settings.linearPhaseOversampling;
+    }
+
+    // The old stage is freed here, outside the lock
+    return dsp.getLatencySamples();
+}
+
+double OverDriveCore::getTailLengthSeconds (const OverDriveSettings& settings) const noexcept
+{
+    // The filters' and crossovers' ring-down at these settings, plus the oversampling latency
+    const auto rate = sampleRate.load();
+    const auto latencySeconds = rate > 0.0 ? getLatencySamples() / rate : 0.0;
+    return OverDriveDSP<float>::getFilterTailSeconds (settings) + latencySeconds;
+}
+
+LevelReading OverDriveCore::getDriveLevel() const noexcept
+{
+    // Read on the audio thread after process, so like process it doesn't wait out a swap
+    const juce::ScopedTryLock sl (processLock);
+
+    if (sl.isLocked())
+    {
+        if (doubleDSP != nullptr)
+            return doubleDSP->getDriveLevel();
+
+        if (floatDSP != nullptr)
+            return floatDSP->getDriveLevel();
+    }
+
+    return {};
+}
+
+MemoryReport OverDriveCore::getMemoryReport() const
+{
+    // The DSP only changes under the setup lock, so this doesn't need to hold up process
+    const juce::ScopedLock setup (setupLock);
+
+    MemoryReport report;
+    report.instanceBytes = sizeof (*this) + sizeof (UserCurve);
+
+    // Only the DSP in the prepared precision exists
+    if (floatDSP != nullptr)
+        report.instanceBytes += sizeof (OverDriveDSP<float>) + floatDSP->getMemoryUsage();
+
+    if (doubleDSP != nullptr)
+        report.instanceBytes += sizeof (OverDriveDSP<double>) + doubleDSP->getMemoryUsage();
+
+    report.sharedBytes = sharedResources->getMemoryUsage();
+    report.numInstances = sharedResources.getReferenceCount();
+    return report;
+}
+
+//==============================================================================
+template bool OverDriveCore::process (juce::AudioBuffer<float>&, int, const OverDriveSettings&, const UserCurve*) noexcept;
+template bool OverDriveCore::process (juce::AudioBuffer<double>&, int, const OverDriveSettings&, const UserCurve*) noexcept;
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    OverDriveCore.h
+    Created: 18 Oct 2026 1:04:37am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "OverDriveDSP.h"
+#include "PresetParameters.h"
+#include "SharedResources.h"
+#include "AudioTrace.h"
+
+/*  The whole effect without the plugin around it: the DSP in both precisions,
+    its parameters, the user curve and the oversampling stage, with no GUI,
+    AudioProcessor or plugin-format code. The plugin is a thin wrapper around
+    one of these, and other hosts (the batch renderer, a server-side pipeline,
+    or C code through OverDriveCoreAPI.h) use it directly.
+
+    Parameters are plain values by PresetParameters::Index, set from any
+    thread. Audio is processed in place on non-interleaved channel pointers,
+    with no copies.
+
+    Threads: prepare, release, update and setUserCurve allocate, so they are
+    for the setup/message thread. prepare, release and update build and free
+    everything outside the lock process takes, and only hold it to swap their
+    result in, so they may run while another thread is processing. process
+    never waits for it: a block that arrives during a swap is left as it was.
+    setUserCurve publishes the new curve with an atomic pointer swap instead,
+    so editing the curve (which happens on every drag) never holds up process.
+    Everything else is realtime safe.
+
+    Changing the oversampling mode needs a new stage, which allocates. process
+    carries on with the old one, and needsUpdate says when update should be
+    called to build the new one (and change the latency).
+
+    Settings passed in are run at their quality tier, or at the render tier
+    while setRenderingOffline is on and the settings ask for that.
+*/
+class OverDriveCore
+{
+public:
+    OverDriveCore();
+    ~OverDriveCore();
+
+    /** The most channels process takes. The caller's channel pointers are wrapped
+        in a juce::AudioBuffer, which only has room for fewer than 32 without
+        allocating.
+    */
+    static constexpr int maxChannels = 31;
+
+    //==============================================================================
+    /** Allocates everything for blocks of up to maximumBlockSize samples (longer
+        blocks are split) and builds the oversampling stage. Only the DSP in the
+        chosen precision is prepared. numChannels is 1 to maxChannels; any more
+        are left untouched by process.
+    */
+    void prepare (double sampleRate, int maximumBlockSize, int numChannels, bool useDoublePrecision = false);
+
+    /** The same, starting from these settings rather than the parameters (the plugin passes a preset's). */
+    void prepare (double sampleRate, int maximumBlockSize, int numChannels, bool useDoublePrecision, const OverDriveSettings& settings);
+    void release();
+
+    /** Clears all filter and oversampling state and jumps the smoothed parameters to their targets. Realtime safe. */
+    void reset() noexcept;
+
+    bool isPrepared() const noexcept                { return sampleRate.load() > 0.0; }
+    bool isUsingDoublePrecision() const noexcept    { return useDouble.load(); }
+    double getSampleRate() const noexcept           { return sampleRate.load(); }
+    int getNumChannels() const noexcept             { return numChannels.load(); }
+
+    //==============================================================================
+    /** Sets a parameter to a plain value, clamped to its range. Safe from any thread. */
+    void setParameter (int index, float plainValue) noexcept;
+    float getParameter (int index) const noexcept;
+
+    void setParameterValues (const ParameterValues& values) noexcept;
+    ParameterValues getParameterValues() const noexcept;
+
+    /** The DSP settings the current parameters add up to. */
+    OverDriveSettings getSettings() const noexcept      { return PresetParameters::toSettings (getParameterValues()); }
+
+    /** The curve used while the Curve parameter is User. Allocates, so not on the audio thread. */
+    void setUserCurve (const UserCurve& newCurve);
+    UserCurve getUserCurve() const;
+
+    void setPipeline (OverDrivePipeline newPipeline) noexcept   { pipeline = newPipeline; }
+
+    /** Switches to the render tier, for offline bounces. This can change the
+        oversampling mode, so call update afterwards (needsUpdate says whether
+        it's due) before processing, for the latency to be right from the first block.
+    */
+    void setRenderingOffline (bool shouldRenderOffline) noexcept    { renderingOffline = shouldRenderOffline; }
+    bool isRenderingOffline() const noexcept                        { return renderingOffline.load(); }
+
+    /** The settings as they will be run, with the tier applied. */
+    OverDriveSettings getEffectiveSettings (const OverDriveSettings& settings) const noexcept;
+
+    //==============================================================================
+    /** Processes the first numChannels channels in place with the current
+        parameters. Channels beyond those prepared for are left untouched.
+        Returns false if the block was skipped and left as it was: it was
+        silent, or prepare, release or update was swapping in new state.
+    */
+    bool process (float* const* channels, int numChannels, int numSamples) noexcept;
+    bool process (double* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** The same with settings (and optionally a user curve) from the caller
+        rather than the parameters. The buffer has to match the prepared precision.
+    */
+    template <typename SampleType>
+    bool process (juce::AudioBuffer<SampleType>& buffer, int numChannels, const OverDriveSettings& settings, const UserCurve* curve) noexcept;
+
+    //==============================================================================
+    /** True once process has seen an oversampling mode the current stage wasn't built for. */
+    bool needsUpdate() const noexcept       { return updateNeeded.load (std::memory_order_relaxed); }
+
+    /** True if these settings need a different oversampling stage from the current one. */
+    bool needsUpdate (const OverDriveSettings& settings) const noexcept;
+
+    /** Builds the oversampling stage for these settings (or the parameters) and
+        swaps it in. Returns the new latency. Allocates, so not on the audio thread.
+    */
+    int update (const OverDriveSettings& settings);
+    int update()                            { return update (getSettings()); }
+
+    /** The added latency, in samples at the host rate. */
+    int getLatencySamples() const noexcept  { return latencySamples.load(); }
+
+    /** How long the output rings on after the input stops, latency included. */
+    double getTailLengthSeconds (const OverDriveSettings& settings) const noexcept;
+    double getTailLengthSeconds() const noexcept    { return getTailLengthSeconds (getSettings()); }
+
+    /** Peak and RMS after the drive stage in the last block, while settings.meterDrive is set. */
+    LevelReading getDriveLevel() const noexcept;
+
+    /** Blocks skipped because the input was silent and the effect had fully rung out. */
+    juce::uint64 getNumSkippedBlocks() const noexcept   { return skippedBlocks.load(); }
+
+    /** Bytes this core holds on its own (itself included), what it shares with
+        every other core in the process, and how many cores share it.
+    */
+    MemoryReport getMemoryReport() const;
+
+    SharedResources& getSharedResources() noexcept      { return sharedResources.get(); }
+
+   #if OVERDRIVE_TRACE
+    /** This core's track in the trace, for the spans its owner records around it. */
+    TraceBuffer& getTraceBuffer() noexcept              { return traceBuffer; }
+   #endif
+
+private:
+    template <typename SampleType>
+    bool processChannels (SampleType* const* channels, int numChannels, int numSamples) noexcept;
+
+    template <typename SampleType>
+    int rebuildOversampling (OverDriveDSP<SampleType>& dsp, const OverDriveSettings& settings);
+
+    template <typename SampleType>
+    std::unique_ptr<OverDriveDSP<SampleType>>& getDSP() noexcept;
+
+    juce::SharedResourcePointer<SharedResources> sharedResources;
+
+   #if OVERDRIVE_TRACE
+    TraceBuffer traceBuffer;
+   #endif
+
+    // Held by process, and by everything else only for a swap or a reset, so
+    // process never waits behind an allocation. process only ever tries it.
+    juce::CriticalSection processLock;
+
+    // Between the setup calls (prepare, release, update and the memory report), which may come from different threads
+    juce::CriticalSection setupLock;
+
+    std::array<std::atomic<float>, PresetParameters::numParameters> parameterValues;
+
+    // Only the one matching the precision exists; the other is null. Swapped under processLock.
+    std::unique_ptr<OverDriveDSP<float>> floatDSP;
+    std::unique_ptr<OverDriveDSP<double>> doubleDSP;
+
+    // The user curve, published to process without a lock. process marks the
+    // curve it is about to use; replaced curves are kept until it has moved
+    // off them, then freed by the next setUserCurve.
+    juce::CriticalSection curveLock;        // Between setUserCurve and getUserCurve callers only
+    std::atomic<const UserCurve*> userCurve { nullptr };
+    std::atomic<const UserCurve*> curveInUse { nullptr };
+    std::vector<std::unique_ptr<UserCurve>> curves;     // The current curve, and any replaced ones process may still be using
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int> numChannels { 0 };
+    std::atomic<bool> useDouble { false };
+
+    std::atomic<OverDrivePipeline> pipeline { OverDrivePipeline::fused };
+    std::atomic<bool> renderingOffline { false };
+    std::atomic<int> latencySamples { 0 };
+    std::atomic<bool> updateNeeded { false };
+    std::atomic<juce::uint64> skippedBlocks { 0 };
+
+    // The mode the current oversampling stage was built for. Written under processLock, read without it.
+    std::atomic<int> activeOversamplingIndex { 0 };
+    std::atomic<bool> activeOversamplingLinearPhase { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OverDriveCore)
+};
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    OverDriveCoreAPI.cpp
+    Created: 18 Oct 2026 1:31:12am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "OverDriveCoreAPI.h"
+#include "OverDriveCore.h"
+
+struct OverDriveCoreHandle
+{
+    OverDriveCore core;
+};
+
+OverDriveCoreHandle* overdrive_core_create (void)
+{
+    // Nothing may throw across the C boundary
+    try
+    {
+        return new OverDriveCoreHandle();
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void overdrive_core_destroy (OverDriveCoreHandle* core)
+{
+    delete core;
+}
+
+int overdrive_core_prepare (OverDriveCoreHandle* core, double sampleRate, int maximumBlockSize, int numChannels, int useDoublePrecision)
+{
+    if (core == nullptr || sampleRate <= 0.0 || maximumBlockSize <= 0 || numChannels <= 0 || numChannels > OverDriveCore::maxChannels)
+        return 0;
+
+    try
+    {
+        core->core.prepare (sampleRate, maximumBlockSize, numChannels, useDoublePrecision != 0);
+        return 1;
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+void overdrive_core_reset (OverDriveCoreHandle* core)
+{
+    if (core != nullptr)
+        core->core.reset();
+}
+
+//==============================================================================
+int overdrive_core_get_num_parameters (void)
+{
+    return PresetParameters::numParameters;
+}
+
+const char* overdrive_core_get_parameter_id (int index)
+{
+    return juce::isPositiveAndBelow (index, (int) PresetParameters::numParameters) ? PresetParameters::ids[index] : nullptr;
+}
+
+int overdrive_core_find_parameter (const char* parameterID)
+{
+    return parameterID != nullptr ? PresetParameters::indexOf (parameterID) : -1;
+}
+
+void overdrive_core_set_parameter (OverDriveCoreHandle* core, int index, float plainValue)
+{
+    if (core != nullptr)
+        core->core.setParameter (index, plainValue);
+}
+
+float overdrive_core_get_parameter (const OverDriveCoreHandle* core, int index)
+{
+    return core != nullptr ? core->core.getParameter (index) : 0.0f;
+}
+
+//==============================================================================
+void overdrive_core_set_rendering_offline (OverDriveCoreHandle* core, int isRenderingOffline)
+{
+    if (core != nullptr)
+        core->core.setRenderingOffline (isRenderingOffline != 0);
+}
+
+int overdrive_core_needs_update (const OverDriveCoreHandle* core)
+{
+    if (core == nullptr || ! core->core.isPrepared())
+        return 0;
+
+    return core->core.needsUpdate() || core->core.needsUpdate (core->core.getSettings()) ? 1 : 0;
+}
+
+int overdrive_core_update (OverDriveCoreHandle* core)
+{
+    if (core == nullptr)
+        return 0;
+
+    try
+    {
+        return core->core.update();
+    }
+    catch (...)
+    {
+        return core->core.getLatencySamples();
+    }
+}
+
+int overdrive_core_get_latency (const OverDriveCoreHandle* core)
+{
+    return core != nullptr ? core->core.getLatencySamples() : 0;
+}
+
+double overdrive_core_get_tail_seconds (const OverDriveCoreHandle* core)
+{
+    return core != nullptr ? core->core.getTailLengthSeconds() : 0.0;
+}
+
+//==============================================================================
+int overdrive_core_process_float (OverDriveCoreHandle* core, float* const* channels, int numChannels, int numSamples)
+{
+    if (core == nullptr || channels == nullptr || ! core->core.isPrepared() || core->core.isUsingDoublePrecision())
+        return -1;
+
+    return core->core.process (channels, numChannels, numSamples) ? 1 : 0;
+}
+
+int overdrive_core_process_double (OverDriveCoreHandle* core, double* const* channels, int numChannels, int numSamples)
+{
+    if (core == nullptr || channels == nullptr || ! core->core.isPrepared() || ! core->core.isUsingDoublePrecision())
+        return -1;
+
+    return core->core.process (channels, numChannels, numSamples) ? 1 : 0;
+}
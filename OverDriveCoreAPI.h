@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    OverDriveCoreAPI.h
+    Created: 18 Oct 2026 1:31:12am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*  C interface to OverDriveCore, for hosts that aren't built with JUCE or C++.
+    This header includes nothing but itself.
+
+        OverDriveCoreHandle* core = overdrive_core_create();
+        overdrive_core_set_parameter (core, overdrive_core_find_parameter ("DRIVE"), 7.5f);
+        overdrive_core_prepare (core, 48000.0, 512, 2, 0);
+
+        // For every block, in place, one pointer per channel
+        overdrive_core_process_float (core, channels, 2, numSamples);
+
+        overdrive_core_destroy (core);
+
+    Parameters are plain values (dB, Hz, percent, or the index of a choice)
+    and can be set from any thread. prepare, update and destroy allocate, so
+    they belong off the audio thread. Changing the oversampling mode only takes
+    effect, and changes the latency, on the next update.
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct OverDriveCoreHandle OverDriveCoreHandle;
+
+/** Returns null if the core couldn't be created. */
+OverDriveCoreHandle* overdrive_core_create (void);
+void overdrive_core_destroy (OverDriveCoreHandle* core);
+
+/** Returns 0 if the arguments are out of range; numChannels can be 1 to 31.
+    Call again whenever the rate, block size or channel count changes.
+*/
+int overdrive_core_prepare (OverDriveCoreHandle* core, double sampleRate, int maximumBlockSize, int numChannels, int useDoublePrecision);
+void overdrive_core_reset (OverDriveCoreHandle* core);
+
+/** Parameters, by index. IDs are those of the plugin, e.g. "DRIVE" or "HPF_FREQ". */
+int overdrive_core_get_num_parameters (void);
+const char* overdrive_core_get_parameter_id (int index);
+int overdrive_core_find_parameter (const char* parameterID);     /* -1 if there is no such parameter */
+void overdrive_core_set_parameter (OverDriveCoreHandle* core, int index, float plainValue);
+float overdrive_core_get_parameter (const OverDriveCoreHandle* core, int index);
+
+/** Non-zero switches to the render quality tier for offline rendering, if the
+    QUALITY and BOUNCE_QUALITY parameters ask for it. Call overdrive_core_update
+    after changing it, before processing.
+*/
+void overdrive_core_set_rendering_offline (OverDriveCoreHandle* core, int isRenderingOffline);
+
+/** Non-zero if a parameter change is waiting for overdrive_core_update. */
+int overdrive_core_needs_update (const OverDriveCoreHandle* core);
+
+/** Applies changes that allocate (the oversampling mode). Returns the latency in samples. */
+int overdrive_core_update (OverDriveCoreHandle* core);
+int overdrive_core_get_latency (const OverDriveCoreHandle* core);
+double overdrive_core_get_tail_seconds (const OverDriveCoreHandle* core);
+
+/** Processes non-interleaved channels in place. Returns 1, or 0 if the block
+    was skipped and left as it was (it was silent, or another thread was
+    swapping in what overdrive_core_prepare or overdrive_core_update built),
+    or -1 if the core isn't prepared for this precision.
+*/
+int overdrive_core_process_float (OverDriveCoreHandle* core, float* const* channels, int numChannels, int numSamples);
+int overdrive_core_process_double (OverDriveCoreHandle* core, double* const* channels, int numChannels, int numSamples);
+
+#ifdef __cplusplus
+}
+#endif
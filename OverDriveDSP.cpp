@@ -0,0 +1,792 @@
+/*
+  ==============================================================================
+
+    OverDriveDSP.cpp
+    Created: 17 Oct 2026 5:12:40pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "OverDriveDSP.h"
+#include "AudioTrace.h"
+
+namespace
+{
+    // Wraps a shaper to measure what comes out of it, for the drive meter
+    template <typename Shaper, typename SampleType>
+    struct MeteredShaper
+    {
+        const Shaper& shaper;
+        LevelMeter<SampleType>& meter;
+
+        void process (const SampleType* input, SampleType* output, int numSamples, SampleType drive, SampleType gain) const noexcept
+        {
+            shaper.process (input, output, numSamples, drive, gain);
+            meter.add (output, numSamples);
+        }
+    };
+}
+
+void applyQualityTier (OverDriveSettings& settings, QualityTier tier) noexcept
+{
+    switch (tier)
+    {
+        case QualityTier::eco:
+            settings.accuracy = SaturationKernel::Accuracy::fast;
+            settings.oversamplingIndex = 0;
+            settings.filterUpdateInterval = 32;
+            settings.antialiasingOrder = 0;
+            break;
+
+        // No oversampling, so nothing to add to the latency while tracking; ADAA keeps the aliasing down instead
+        case QualityTier::live:
+            settings.accuracy = SaturationKernel::Accuracy::balanced;
+            settings.oversamplingIndex = 0;
+            settings.filterUpdateInterval = 16;
+            settings.antialiasingOrder = 1;
+            break;
+
+        case QualityTier::render:
+            settings.accuracy = SaturationKernel::Accuracy::accurate;
+            settings.oversamplingIndex = 3;
+            settings.linearPhaseOversampling = true;
+            settings.filterUpdateInterval = 8;
+            settings.antialiasingOrder = 1;
+            break;
+
+        case QualityTier::custom:
+        default:
+            break;
+    }
+
+    if (settings.multiband.numBands > 1)
+    {
+        settings.oversamplingIndex = 0;
+        settings.antialiasingOrder = 0;
+    }
+}
+
+template <typename SampleType>
+OverDriveDSP<SampleType>::OversamplingStage::OversamplingStage (const juce::dsp::ProcessSpec& spec, int factorIndex, bool useLinearPhase,
+                                                                 std::shared_ptr<const DiodeClipperTable> clipperTableAtOversampledRate)
+    : oversampler (spec.numChannels, (size_t) factorIndex,
+                   useLinearPhase ? juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple
+                                  : juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR,
+                   true, true), // Integer latency, so the dry path can be delayed without interpolation
+      clipperTable (std::move (clipperTableAtOversampledRate))
+{
+    jassert (clipperTable != nullptr);
+
+    oversampler.initProcessing (spec.maximumBlockSize);
+    latencySamples = (int) oversampler.getLatencyInSamples();
+
+    dryDelay.prepare (spec);
+    dryDelay.setMaximumDelayInSamples (juce::jmax (1, latencySamples));
+    dryDelay.setDelay ((SampleType) latencySamples);
+}
+
+//==============================================================================
+template <typename SampleType>
+void OverDriveDSP<SampleType>::prepare (const juce::dsp::ProcessSpec& newSpec, const OverDriveSettings& settings, std::shared_ptr<const CutoffTable> table,
+                                        std::shared_ptr<const DiodeClipperTable> newClipperTable)
+{
+    jassert (table != nullptr && newClipperTable != nullptr);
+
+    spec = newSpec;
+    cutoffTable = std::move (table);
+    clipperTable = std::move (newClipperTable);
+
+    const auto sampleRate = spec.sampleRate;
+    const auto numChannels = (int) spec.numChannels;
+    const auto samplesPerBlock = (int) spec.maximumBlockSize;
+
+    highPassState.assign ((size_t) numChannels, {});
+    antialiasing.prepare (numChannels);
+    diodeClipper.prepare (numChannels);
+    diodeClipper.setTable (clipperTable.get());
+    diodeClipper.setTone (settings.tonePercent);
+    driveModel = settings.driveModel;
+    lowPassState.assign ((size_t) numChannels, {});
+    coefficientSchedule.resize ((size_t) (samplesPerBlock / minimumFilterUpdateInterval + 1));
+
+    driveSmoothed.reset (sampleRate, 0.02);
+    gainSmoothed.reset (sampleRate, 0.02);
+    mixSmoothed.reset (sampleRate, 0.02);
+    highPassSmoothed.reset (sampleRate, 0.05);
+    lowPassSmoothed.reset (sampleRate, 0.05);
+
+    driveSmoothed.setCurrentAndTargetValue (settings.drive);
+    gainSmoothed.setCurrentAndTargetValue (juce::Decibels::decibelsToGain (settings.gainDecibels));
+    mixSmoothed.setCurrentAndTargetValue (settings.mixPercent / 100.0f);
+    highPassSmoothed.setCurrentAndTargetValue (CutoffTable::getPosition (settings.highPassHz));
+    lowPassSmoothed.setCurrentAndTargetValue (CutoffTable::getPosition (settings.lowPassHz));
+
+    setFilterSlopes (settings);
+    steadyCoefficients = makeFilterCoefficients (highPassSmoothed.getTargetValue(), lowPassSmoothed.getTargetValue());
+    steadyCoefficientsValid = true;
+
+    multiband.prepare (numChannels, samplesPerBlock, sampleRate, *cutoffTable, settings.multiband);
+
+    // All scratch storage is allocated here, never on the audio thread
+    wetBuffer.setSize (numChannels, samplesPerBlock);
+    rampBuffer.setSize (3, samplesPerBlock);
+    laneScratch.setSize (numChannelLanes<SampleType> - 1, samplesPerBlock);
+    laneScratch.clear();
+
+    oversampling.reset();
+    silentSamples = 0;
+    idle = false;
+}
+
+template <typename SampleType>
+void OverDriveDSP<SampleType>::release()
+{
+    wetBuffer.setSize (0, 0);
+    rampBuffer.setSize (0, 0);
+    laneScratch.setSize (0, 0);
+    oversampling.reset();
+    diodeClipper.setTable (nullptr);
+    clipperTable.reset();
+    cutoffTable.reset();
+    spec = {};
+}
+
+template <typename SampleType>
+void OverDriveDSP<SampleType>::reset() noexcept
+{
+    clearState();
+
+    for (auto* smoothed : { &driveSmoothed, &gainSmoothed, &mixSmoothed, &highPassSmoothed, &lowPassSmoothed })
+        smoothed->setCurrentAndTargetValue (smoothed->getTargetValue());
+
+    steadyCoefficientsValid = false;
+    silentSamples = 0;
+    idle = false;
+}
+
+template <typename SampleType>
+void OverDriveDSP<SampleType>::clearState() noexcept
+{
+    std::fill (highPassState.begin(), highPassState.end(), TPTCascadeState<SampleType>());
+    std::fill (lowPassState.begin(), lowPassState.end(), TPTCascadeState<SampleType>());
+    antialiasing.reset();
+    diodeClipper.reset();
+    multiband.reset();
+
+    if (oversampling != nullptr)
+    {
+        oversampling->oversampler.reset();
+        oversampling->dryDelay.reset();
+    }
+}
+
+template <typename SampleType>
+size_t OverDriveDSP<SampleType>::getMemoryUsage() const noexcept
+{
+    const auto bufferBytes = [] (const juce::AudioBuffer<SampleType>& buffer)
+    {
+        return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof (SampleType);
+    };
+
+    auto bytes = highPassState.capacity() * sizeof (TPTCascadeState<SampleType>)
+               + lowPassState.capacity() * sizeof (TPTCascadeState<SampleType>)
+               + coefficientSchedule.capacity() * sizeof (typename Block::FilterCoefficients)
+               + bufferBytes (wetBuffer) + bufferBytes (rampBuffer) + bufferBytes (laneScratch)
+               + antialiasing.getMemoryUsage() + diodeClipper.getMemoryUsage() + multiband.getMemoryUsage();
+
+    if (oversampling != nullptr)
+    {
+        // juce::dsp::Oversampling doesn't report its buffers, but each stage holds one at its own rate: 2x, 4x ... up to the factor
+        const auto factor = oversampling->oversampler.getOversamplingFactor();
+        const auto channelSamples = (size_t) spec.numChannels * (size_t) spec.maximumBlockSize;
+
+        bytes += sizeof (OversamplingStage)
+               + channelSamples * (2 * factor - 2) * sizeof (SampleType)
+               + (size_t) spec.numChannels * (size_t) (oversampling->latencySamples + 1) * sizeof (SampleType);
+    }
+
+    return bytes;
+}
+
+template <typename SampleType>
+void OverDriveDSP<SampleType>::swapOversampling (std::unique_ptr<OversamplingStage>& stage) noexcept
+{
+    std::swap (oversampling, stage);
+    diodeClipper.setTable (oversampling != nullptr ? oversampling->clipperTable.get() : clipperTable.get());
+}
+
+//==============================================================================
+template <typename SampleType>
+bool OverDriveDSP<SampleType>::process (juce::AudioBuffer<SampleType>& buffer, int numChannels,
+                                        const OverDriveSettings& settings, OverDrivePipeline pipeline) noexcept
+{
+    driveSmoothed.setTargetValue (settings.drive);
+    gainSmoothed.setTargetValue (juce::Decibels::decibelsToGain (settings.gainDecibels));
+    mixSmoothed.setTargetValue (settings.mixPercent / 100.0f); // Convert mix to 0.0 - 1.0 range
+    highPassSmoothed.setTargetValue (CutoffTable::getPosition (settings.highPassHz));
+    lowPassSmoothed.setTargetValue (CutoffTable::getPosition (settings.lowPassHz));
+    setFilterSlopes (settings);
+
+    filterUpdateInterval = juce::jmax (minimumFilterUpdateInterval, settings.filterUpdateInterval);
+    meterDrive = settings.meterDrive;
+    driveMeter.reset();
+    saturation.setAccuracy (settings.accuracy);
+    curve = settings.curve;
+    multiband.setSettings (settings.multiband);
+    diodeClipper.setTone (settings.tonePercent);
+
+    // The clipper's state is stale after a spell on the curves, so it starts again from rest
+    if (settings.driveModel != driveModel)
+    {
+        diodeClipper.reset();
+        driveModel = settings.driveModel;
+    }
+
+    // ADAA needs the curve's antiderivatives, which only tanh has here
+    antialiasing.setOrder (curve == WaveshaperCurve::tanh ? (typename AntiderivativeSaturation<SampleType>::Order) juce::jlimit (0, 2, settings.antialiasingOrder)
+                                                          : AntiderivativeSaturation<SampleType>::Order::off);
+
+    // Hosts may send more samples than announced in prepareToPlay, so work in chunks that fit the scratch buffer
+    const auto maxChunkSize = wetBuffer.getNumSamples();
+    numChannels = juce::jmin (numChannels, wetBuffer.getNumChannels());
+
+    if (maxChunkSize == 0)
+        return true;
+
+    // Silent input through a fully decayed chain can only produce silence, so skip the work
+    if (isSilent (buffer, numChannels))
+    {
+        if (idle || hasDecayed())
+        {
+            if (! idle)
+            {
+                // Start again from exact zeros when the input comes back
+                clearState();
+                idle = true;
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                buffer.clear (channel, 0, buffer.getNumSamples());
+
+            return false;
+        }
+
+        silentSamples = juce::jmin (silentSamples, std::numeric_limits<int>::max() - buffer.getNumSamples()) + buffer.getNumSamples();
+    }
+    else
+    {
+        silentSamples = 0;
+        idle = false;
+    }
+
+    for (int startSample = 0; startSample < buffer.getNumSamples(); startSample += maxChunkSize)
+    {
+        const auto numSamples = juce::jmin (maxChunkSize, buffer.getNumSamples() - startSample);
+        processChunk (buffer, numChannels, startSample, numSamples, pipeline);
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+bool OverDriveDSP<SampleType>::isSilent (const juce::AudioBuffer<SampleType>& buffer, int numChannels) const noexcept
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+        if (buffer.getMagnitude (channel, 0, buffer.getNumSamples()) > silenceThreshold)
+            return false;
+
+    return true;
+}
+
+template <typename SampleType>
+bool OverDriveDSP<SampleType>::hasDecayed() const noexcept
+{
+    // A moving parameter would still change the output
+    if (driveSmoothed.isSmoothing() || gainSmoothed.isSmoothing() || mixSmoothed.isSmoothing()
+         || highPassSmoothed.isSmoothing() || lowPassSmoothed.isSmoothing())
+        return false;
+
+    for (const auto* states : { &highPassState, &lowPassState })
+        for (const auto& sections : *states)
+            for (const auto& state : sections)
+                if (std::abs (state.s1) > silenceThreshold || std::abs (state.s2) > silenceThreshold)
+                    return false;
+
+    // The oversampling filters and the dry delay hide their state, so wait for
+    // enough silence to have passed through them: the latency, plus a generous
+    // allowance for the half-band filters' ringing
+    if (oversampling != nullptr && silentSamples < 4 * oversampling->latencySamples)
+        return false;
+
+    if (driveModel == DriveModel::diodeClipper && ! diodeClipper.hasDecayed (silenceThreshold))
+        return false;
+
+    return multiband.hasDecayed (silenceThreshold);
+}
+
+template <typename SampleType>
+double OverDriveDSP<SampleType>::getFilterTailSeconds (const OverDriveSettings& settings) noexcept
+{
+    // Each section rings at the rate of its slowest pole: zeta * w0 when it is
+    // underdamped. Everything is in series, so the tails add up.
+    const auto decayNepers = std::log (1.0 / (double) silenceThreshold);
+
+    auto tailSeconds = [&] (double cutoffHz, int numSections)
+    {
+        const auto w0 = juce::MathConstants<double>::twoPi * juce::jmax (1.0, cutoffHz);
+        const auto& resonances = FilterSlopes::getSectionResonances (settings.filterAlignment, numSections);
+        auto seconds = 0.0;
+
+        for (int section = 0; section < juce::jlimit (1, maxTPTSections, numSections); ++section)
+        {
+            const auto zeta = 0.5 / resonances[(size_t) section];
+            const auto decayRate = zeta < 1.0 ? zeta * w0 : w0 * (zeta - std::sqrt (zeta * zeta - 1.0));
+            seconds += decayNepers / decayRate;
+        }
+
+        return seconds;
+    };
+
+    auto seconds = tailSeconds (settings.highPassHz, settings.highPassSections) + tailSeconds (settings.lowPassHz, settings.lowPassSections);
+
+    // Multiband mode has crossovers in front; otherwise the diode clipper may be
+    if (settings.multiband.numBands > 1)
+        seconds += MultibandDrive<SampleType>::getTailSeconds (settings.multiband, decayNepers);
+    else if (settings.driveModel == DriveModel::diodeClipper)
+        seconds += DiodeClipper<SampleType>::getTailSeconds (settings.tonePercent, decayNepers);
+
+    return seconds;
+}
+
+template <typename SampleType>
+double OverDriveDSP<SampleType>::getFilterResponse (const OverDriveSettings& settings, double sampleRate, double frequencyHz) noexcept
+{
+    auto response = [&] (double cutoffHz, int numSections, bool highPass)
+    {
+        const auto& resonances = FilterSlopes::getSectionResonances (settings.filterAlignment, numSections);
+        auto magnitude = 1.0;
+
+        for (int section = 0; section < juce::jlimit (1, maxTPTSections, numSections); ++section)
+            magnitude *= TPTCoefficients<double>::make (sampleRate, cutoffHz, resonances[(size_t) section]).getMagnitude (sampleRate, frequencyHz, highPass);
+
+        return magnitude;
+    };
+
+    return response (settings.highPassHz, settings.highPassSections, true) * response (settings.lowPassHz, settings.lowPassSections, false);
+}
+
+template <typename SampleType>
+void OverDriveDSP<SampleType>::setFilterSlopes (const OverDriveSettings& settings) noexcept
+{
+    const auto newHighPassSections = juce::jlimit (1, maxTPTSections, settings.highPassSections);
+    const auto newLowPassSections = juce::jlimit (1, maxTPTSections, settings.lowPassSections);
+
+    if (newHighPassSections == highPassSections && newLowPassSections == lowPassSections && settings.filterAlignment == filterAlignment)
+        return;
+
+    // Sections that drop out are cleared, so they start from rest if they come back
+    for (auto& sections : highPassState)
+        std::fill (sections.begin() + newHighPassSections, sections.end(), TPTState<SampleType>());
+
+    for (auto& sections : lowPassState)
+        std::fill (sections.begin() + newLowPassSections, sections.end(), TPTState<SampleType>());
+
+    highPassSections = newHighPassSections;
+    lowPassSections = newLowPassSections;
+    filterAlignment = settings.filterAlignment;
+    steadyCoefficientsValid = false;
+}
+
+template <typename SampleType>
+typename PipelineBlock<SampleType>::FilterCoefficients OverDriveDSP<SampleType>::makeFilterCoefficients (float highPassPosition,
+                                                                                                         float lowPassPosition) const noexcept
+{
+    return { FilterSlopes::makeCascade<SampleType> (cutoffTable->getWarpedCutoff (highPassPosition), filterAlignment, highPassSections),
+             FilterSlopes::makeCascade<SampleType> (cutoffTable->getWarpedCutoff (lowPassPosition), filterAlignment, lowPassSections) };
+}
+
+template <typename SampleType>
+void OverDriveDSP<SampleType>::processChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample, int numSamples,
+                                             OverDrivePipeline pipeline) noexcept
+{
+    const auto block = preparePipelineBlock (numSamples);
+
+    if (multiband.isEnabled())
+        multiband.prepareSchedule (numSamples);
+
+    auto run = [&] (const auto& shaper)
+    {
+        using Shaper = std::decay_t<decltype (shaper)>;
+
+        if (meterDrive)
+            processChunk (buffer, numChannels, startSample, block, pipeline, MeteredShaper<Shaper, SampleType> { shaper, driveMeter });
+        else
+            processChunk (buffer, numChannels, startSample, block, pipeline, shaper);
+    };
+
+    // The curve is chosen here, once per chunk; each one gets its own copy of the pipeline
+    switch (curve)
+    {
+        case WaveshaperCurve::tube:         run (Waveshaper<WaveshaperShapes::Tube>());                  break;
+        case WaveshaperCurve::softClip:     run (Waveshaper<WaveshaperShapes::SoftClip>());              break;
+        case WaveshaperCurve::hardClip:     run (Waveshaper<WaveshaperShapes::HardClip>());              break;
+        case WaveshaperCurve::foldback:     run (Waveshaper<WaveshaperShapes::Foldback>());              break;
+        case WaveshaperCurve::user:         run (Waveshaper<WaveshaperShapes::User> { { userCurve } });  break;
+        case WaveshaperCurve::tanh:
+        default:                            run (saturation);                                            break;
+    }
+}
+
+template <typename SampleType>
+template <typename Shaper>
+void OverDriveDSP<SampleType>::processChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample, const Block& block,
+                                             OverDrivePipeline pipeline, const Shaper& shaper) noexcept
+{
+    if (multiband.isEnabled())
+    {
+        processMultibandChunk (buffer, numChannels, startSample, block, shaper);
+        return;
+    }
+
+    // The fused path can't run the drive stage at a different rate, or carry
+    // ADAA's or the diode clipper's history between samples, so those use the reference path
+    if (oversampling != nullptr || antialiasing.getOrder() != AntiderivativeSaturation<SampleType>::Order::off
+         || driveModel == DriveModel::diodeClipper || pipeline == OverDrivePipeline::reference)
+    {
+        processReferenceChunk (buffer, numChannels, startSample, block, shaper);
+        return;
+    }
+
+    // Saturation, filters and mix run in one pass here, so they can only be timed together
+    OVERDRIVE_TRACE_SPAN ("fused");
+
+    const auto rampedDrive = block.driveRamp != nullptr;
+    const auto rampedMix = block.dryRamp != nullptr;
+    constexpr auto lanes = numChannelLanes<SampleType>;
+
+    // Two or more channels run a SIMD register's worth at a time, one per lane.
+    // A partial group is padded with scratch lanes, which still costs less than
+    // running its channels one by one.
+    int channel = 0;
+
+    for (; numChannels - channel >= 2; channel += lanes)
+    {
+        const auto numReal = juce::jmin (lanes, numChannels - channel);
+        SampleType* channels[lanes];
+        auto* highPass = highPassState.data() + channel;
+        auto* lowPass = lowPassState.data() + channel;
+        TPTCascadeState<SampleType> padHighPass[lanes], padLowPass[lanes];
+
+        for (int lane = 0; lane < lanes; ++lane)
+            channels[lane] = lane < numReal ? buffer.getWritePointer (channel + lane, startSample)
+                                            : laneScratch.getWritePointer (lane - numReal);
+
+        if (numReal < lanes)
+        {
+            std::copy (highPass, highPass + numReal, padHighPass);
+            std::copy (lowPass, lowPass + numReal, padLowPass);
+            highPass = padHighPass;
+            lowPass = padLowPass;
+        }
+
+        if (rampedDrive)
+        {
+            if (rampedMix)  processFusedChannelGroup<true, true>   (block, shaper, highPass, lowPass, channels);
+            else            processFusedChannelGroup<true, false>  (block, shaper, highPass, lowPass, channels);
+        }
+        else
+        {
+            if (rampedMix)  processFusedChannelGroup<false, true>  (block, shaper, highPass, lowPass, channels);
+            else            processFusedChannelGroup<false, false> (block, shaper, highPass, lowPass, channels);
+        }
+
+        if (numReal < lanes)
+        {
+            std::copy (padHighPass, padHighPass + numReal, highPassState.data() + channel);
+            std::copy (padLowPass, padLowPass + numReal, lowPassState.data() + channel);
+
+            // The padding lanes are silent, so only their sample count needs taking back out
+            if (meterDrive)
+                driveMeter.numSamples -= (lanes - numReal) * block.numSamples;
+        }
+    }
+
+    for (; channel < numChannels; ++channel)
+    {
+        auto* channelData = buffer.getWritePointer (channel, startSample);
+        auto& highPass = highPassState[(size_t) channel];
+        auto& lowPass = lowPassState[(size_t) channel];
+
+        if (rampedDrive)
+        {
+            if (rampedMix)  processFusedChannel<true, true>   (block, shaper, highPass, lowPass, channelData);
+            else            processFusedChannel<true, false>  (block, shaper, highPass, lowPass, channelData);
+        }
+        else
+        {
+            if (rampedMix)  processFusedChannel<false, true>  (block, shaper, highPass, lowPass, channelData);
+            else            processFusedChannel<false, false> (block, shaper, highPass, lowPass, channelData);
+        }
+    }
+}
+
+template <typename SampleType>
+PipelineBlock<SampleType> OverDriveDSP<SampleType>::preparePipelineBlock (int numSamples) noexcept
+{
+    Block block;
+    block.numSamples = numSamples;
+
+    // A steady drive is folded into the saturation kernel. While it ramps it is
+    // applied per sample before the kernel instead.
+    if (driveSmoothed.isSmoothing())
+    {
+        auto* driveRamp = rampBuffer.getWritePointer (0);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+            driveRamp[sample] = (SampleType) driveSmoothed.getNextValue();
+
+        block.driveRamp = driveRamp;
+    }
+    else
+    {
+        block.drive = (SampleType) driveSmoothed.getTargetValue();
+    }
+
+    // While a cutoff moves, the filter coefficients are recalculated every
+    // filterUpdateInterval samples rather than once per block, from the table
+    if (highPassSmoothed.isSmoothing() || lowPassSmoothed.isSmoothing())
+    {
+        size_t slot = 0;
+
+        for (int offset = 0; offset < numSamples; offset += filterUpdateInterval)
+        {
+            const auto subBlockSize = juce::jmin (filterUpdateInterval, numSamples - offset);
+            coefficientSchedule[slot++] = makeFilterCoefficients (highPassSmoothed.skip (subBlockSize), lowPassSmoothed.skip (subBlockSize));
+        }
+
+        steadyCoefficients = coefficientSchedule[slot - 1];
+        block.coefficients = coefficientSchedule.data();
+        block.coefficientInterval = filterUpdateInterval;
+    }
+    else
+    {
+        if (! steadyCoefficientsValid)
+            steadyCoefficients = makeFilterCoefficients (highPassSmoothed.getTargetValue(), lowPassSmoothed.getTargetValue());
+
+        block.coefficients = &steadyCoefficients;
+        block.coefficientInterval = juce::jmax (1, numSamples);
+    }
+
+    steadyCoefficientsValid = true;
+
+    // The output gain is folded into the wet coefficient of the mix
+    if (mixSmoothed.isSmoothing() || gainSmoothed.isSmoothing())
+    {
+        auto* dryRamp = rampBuffer.getWritePointer (1);
+        auto* wetRamp = rampBuffer.getWritePointer (2);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            const auto mix = mixSmoothed.getNextValue();
+            dryRamp[sample] = (SampleType) (1.0f - mix);
+            wetRamp[sample] = (SampleType) (mix * gainSmoothed.getNextValue());
+        }
+
+        block.dryRamp = dryRamp;
+        block.wetRamp = wetRamp;
+    }
+    else
+    {
+        const auto mix = mixSmoothed.getTargetValue();
+        block.dryGain = (SampleType) (1.0f - mix);
+        block.wetGain = (SampleType) (mix * gainSmoothed.getTargetValue());
+    }
+
+    return block;
+}
+
+template <typename SampleType>
+template <typename Shaper>
+void OverDriveDSP<SampleType>::processReferenceChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample,
+                                                      const Block& block, const Shaper& shaper) noexcept
+{
+    const auto numSamples = block.numSamples;
+
+    auto dryBlock = juce::dsp::AudioBlock<SampleType> (buffer).getSubsetChannelBlock (0, (size_t) numChannels)
+                                                              .getSubBlock ((size_t) startSample, (size_t) numSamples);
+    auto wetBlock = juce::dsp::AudioBlock<SampleType> (wetBuffer).getSubsetChannelBlock (0, (size_t) numChannels)
+                                                                 .getSubBlock (0, (size_t) numSamples);
+
+    {
+        OVERDRIVE_TRACE_SPAN ("saturation");
+
+        juce::dsp::AudioBlock<const SampleType> driveInput (dryBlock);
+        auto drive = block.drive;
+
+        if (block.driveRamp != nullptr)
+        {
+            for (size_t channel = 0; channel < (size_t) numChannels; ++channel)
+                juce::FloatVectorOperations::multiply (wetBlock.getChannelPointer (channel), dryBlock.getChannelPointer (channel),
+                                                       block.driveRamp, numSamples);
+
+            driveInput = juce::dsp::AudioBlock<const SampleType> (wetBlock);
+            drive = 1;
+        }
+
+        if (oversampling != nullptr)
+        {
+            // Apply overdrive effect at the oversampled rate
+            auto oversampledBlock = oversampling->oversampler.processSamplesUp (driveInput);
+
+            for (size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
+            {
+                auto* channelData = oversampledBlock.getChannelPointer (channel);
+                saturate (shaper, (int) channel, channelData, channelData, (int) oversampledBlock.getNumSamples(), drive);
+            }
+
+            oversampling->oversampler.processSamplesDown (wetBlock);
+
+            // Keep the dry signal aligned with the delayed wet signal
+            juce::dsp::ProcessContextReplacing<SampleType> dryContext (dryBlock);
+            oversampling->dryDelay.process (dryContext);
+        }
+        else
+        {
+            for (size_t channel = 0; channel < (size_t) numChannels; ++channel)
+            {
+                // Apply overdrive effect
+                saturate (shaper, (int) channel, driveInput.getChannelPointer (channel), wetBlock.getChannelPointer (channel),
+                          numSamples, drive);
+            }
+        }
+    }
+
+    filterAndMix (dryBlock, wetBlock, block);
+}
+
+template <typename SampleType>
+template <typename Shaper>
+void OverDriveDSP<SampleType>::processMultibandChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample,
+                                                      const Block& block, const Shaper& shaper) noexcept
+{
+    // The drive stage splits each channel into bands and sums them again; the
+    // summed bands replace the dry signal, so the mix lines up with the wet one
+    {
+        OVERDRIVE_TRACE_SPAN ("multiband drive");
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            multiband.process (shaper, channel, buffer.getWritePointer (channel, startSample), wetBuffer.getWritePointer (channel), block.numSamples);
+    }
+
+    // The padding lanes are silent, so only their sample count needs taking back out
+    if (meterDrive)
+        driveMeter.numSamples -= multiband.getNumPaddingLanes() * block.numSamples * numChannels;
+
+    filterAndMix (juce::dsp::AudioBlock<SampleType> (buffer).getSubsetChannelBlock (0, (size_t) numChannels)
+                                                           .getSubBlock ((size_t) startSample, (size_t) block.numSamples),
+                  juce::dsp::AudioBlock<SampleType> (wetBuffer).getSubsetChannelBlock (0, (size_t) numChannels)
+                                                              .getSubBlock (0, (size_t) block.numSamples),
+                  block);
+}
+
+template <typename SampleType>
+void OverDriveDSP<SampleType>::filterAndMix (juce::dsp::AudioBlock<SampleType> dryBlock, juce::dsp::AudioBlock<SampleType> wetBlock,
+                                             const Block& block) noexcept
+{
+    const auto numChannels = (int) dryBlock.getNumChannels();
+    const auto numSamples = block.numSamples;
+
+    // Apply high-pass filter, one section at a time
+    {
+        OVERDRIVE_TRACE_SPAN ("hpf");
+
+        for (size_t channel = 0; channel < (size_t) numChannels; ++channel)
+        {
+            auto* wetChannelData = wetBlock.getChannelPointer (channel);
+
+            for (int section = 0; section < highPassSections; ++section)
+            {
+                auto& state = highPassState[channel][(size_t) section];
+
+                for (int sample = 0; sample < numSamples; ++sample)
+                    wetChannelData[sample] = processTPTHighPass (wetChannelData[sample],
+                                                                 block.coefficients[sample / block.coefficientInterval].highPass.sections[(size_t) section],
+                                                                 state.s1, state.s2);
+
+                juce::dsp::util::snapToZero (state.s1);
+                juce::dsp::util::snapToZero (state.s2);
+            }
+        }
+    }
+
+    // Apply low-pass filter
+    {
+        OVERDRIVE_TRACE_SPAN ("lpf");
+
+        for (size_t channel = 0; channel < (size_t) numChannels; ++channel)
+        {
+            auto* wetChannelData = wetBlock.getChannelPointer (channel);
+
+            for (int section = 0; section < lowPassSections; ++section)
+            {
+                auto& state = lowPassState[channel][(size_t) section];
+
+                for (int sample = 0; sample < numSamples; ++sample)
+                    wetChannelData[sample] = processTPTLowPass (wetChannelData[sample],
+                                                                block.coefficients[sample / block.coefficientInterval].lowPass.sections[(size_t) section],
+                                                                state.s1, state.s2);
+
+                juce::dsp::util::snapToZero (state.s1);
+                juce::dsp::util::snapToZero (state.s2);
+            }
+        }
+    }
+
+    // Apply wet/dry mix
+    OVERDRIVE_TRACE_SPAN ("mix");
+
+    for (size_t channel = 0; channel < (size_t) numChannels; ++channel)
+    {
+        auto* dryChannelData = dryBlock.getChannelPointer (channel);
+        auto* wetChannelData = wetBlock.getChannelPointer (channel);
+
+        if (block.dryRamp != nullptr)
+        {
+            juce::FloatVectorOperations::multiply (dryChannelData, block.dryRamp, numSamples);
+            juce::FloatVectorOperations::addWithMultiply (dryChannelData, wetChannelData, block.wetRamp, numSamples);
+        }
+        else
+        {
+            juce::FloatVectorOperations::multiply (dryChannelData, block.dryGain, numSamples);
+            juce::FloatVectorOperations::addWithMultiply (dryChannelData, wetChannelData, block.wetGain, numSamples);
+        }
+    }
+}
+
+template <typename SampleType>
+template <typename Shaper>
+void OverDriveDSP<SampleType>::saturate (const Shaper& shaper, int channel, const SampleType* input, SampleType* output,
+                                         int numSamples, SampleType drive) noexcept
+{
+    if (driveModel == DriveModel::diodeClipper)
+    {
+        diodeClipper.process (channel, input, output, numSamples, drive);
+
+        if (meterDrive)
+            driveMeter.add (output, numSamples);
+    }
+    else if (antialiasing.getOrder() != AntiderivativeSaturation<SampleType>::Order::off)
+    {
+        antialiasing.process (channel, input, output, numSamples, drive);
+
+        if (meterDrive)
+            driveMeter.add (output, numSamples);
+    }
+    else
+        shaper.process (input, output, numSamples, drive, (SampleType) 1);
+}
+
+//==============================================================================
+template class OverDriveDSP<float>;
+template class OverDriveDSP<double>;
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    OverDriveDSP.h
+    Created: 17 Oct 2026 5:12:40pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "SaturationKernel.h"
+#include "AntiderivativeSaturation.h"
+#include "WaveshaperCurves.h"
+#include "AudioTelemetry.h"
+#include "FusedPipeline.h"
+#include "FilterSlopes.h"
+#include "MultibandDrive.h"
+#include "DiodeClipper.h"
+
+/** Bundles of the cost-related settings: saturation accuracy, oversampling,
+    filter update interval and ADAA. Eco is the cheapest, live adds no latency,
+    and render is the best there is, for offline bounces. Custom uses the
+    individual settings as they are.
+*/
+enum class QualityTier
+{
+    custom,
+    eco,
+    live,
+    render
+};
+
+/** Plain parameter values for one block, as read from the plugin's parameters. */
+struct OverDriveSettings
+{
+    float drive = 5.0f;
+    float gainDecibels = 1.0f;
+    float mixPercent = 50.0f;
+    float highPassHz = 20.0f;
+    float lowPassHz = 20000.0f;
+    int highPassSections = 1;           // Slope in 12 dB/oct steps, 1 to maxTPTSections
+    int lowPassSections = 1;
+    FilterAlignment filterAlignment = FilterAlignment::butterworth;
+    WaveshaperCurve curve = WaveshaperCurve::tanh;
+    SaturationKernel::Accuracy accuracy = SaturationKernel::Accuracy::accurate;
+    int filterUpdateInterval = 16;      // Samples between filter coefficient updates while a cutoff moves
+    int oversamplingIndex = 0;          // 0 = off, 1 = 2x, 2 = 4x, 3 = 8x
+    bool linearPhaseOversampling = false;
+    int antialiasingOrder = 0;          // 0 = off, 1 = first order ADAA, 2 = second order ADAA (tanh curve only)
+    bool meterDrive = false;            // Measure the level after the drive stage, for getDriveLevel()
+    MultibandSettings multiband;        // With 2 or more bands, the per-band drives replace drive
+    QualityTier quality = QualityTier::custom;
+    bool renderTierOffline = true;      // Switch to the render tier while rendering offline, unless the tier is custom
+    DriveModel driveModel = DriveModel::waveshaper;     // The diode clipper replaces the curve, ADAA included (single band only)
+    float tonePercent = 50.0f;          // The diode clipper's tone control
+};
+
+/** Sets the accuracy, oversampling, filter update interval and ADAA for a
+    tier (custom leaves them alone). Multiband mode uses neither oversampling
+    nor ADAA, so they are turned off for it whatever the tier, and don't add
+    latency.
+*/
+void applyQualityTier (OverDriveSettings& settings, QualityTier tier) noexcept;
+
+/** The fused single-pass path is the default. The reference path keeps one
+    pass per stage; it is always used while oversampling, ADAA or the diode
+    clipper is on, and can be forced to compare the two.
+*/
+enum class OverDrivePipeline
+{
+    fused,
+    reference
+};
+
+//==============================================================================
+/** Drive, HPF, LPF and wet/dry mix, templated on the sample type so float and
+    double sessions run the same code, SIMD kernels included.
+
+    In multiband mode the drive stage is split into bands by MultibandDrive, and
+    the dry side of the mix is the bands summed, so both sides have been through
+    the same crossovers. Oversampling, ADAA and the diode clipper aren't used
+    in that mode.
+*/
+template <typename SampleType>
+class OverDriveDSP
+{
+public:
+    // Oversamples only the nonlinear stage. The dry path is delayed by the same
+    // latency so the wet/dry mix stays phase-aligned.
+    struct OversamplingStage
+    {
+        OversamplingStage (const juce::dsp::ProcessSpec& spec, int factorIndex, bool useLinearPhase,
+                           std::shared_ptr<const DiodeClipperTable> clipperTableAtOversampledRate);
+
+        juce::dsp::Oversampling<SampleType> oversampler;
+        juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None> dryDelay;
+        int latencySamples = 0;
+        std::shared_ptr<const DiodeClipperTable> clipperTable;
+    };
+
+    /** Allocates all scratch storage, so process() never does. The cutoff and
+        diode clipper tables are shared with other instances at this sample rate
+        (see SharedResources) and held until the next prepare or release.
+    */
+    void prepare (const juce::dsp::ProcessSpec& newSpec, const OverDriveSettings& settings, std::shared_ptr<const CutoffTable> table,
+                  std::shared_ptr<const DiodeClipperTable> clipperTable);
+    void release();
+
+    /** Clears the filter, ADAA, diode clipper, multiband and oversampling state and jumps
+        drive, gain, mix and the cutoffs to their targets, as if starting a new
+        stream.
+    */
+    void reset() noexcept;
+
+    bool isPrepared() const noexcept                            { return spec.maximumBlockSize > 0; }
+    const juce::dsp::ProcessSpec& getSpec() const noexcept      { return spec; }
+
+    /** Exchanges the oversampling stage (null turns it off). The old stage comes
+        back through the same pointer, to be freed by the caller off the audio
+        thread. The diode clipper moves to the stage's rate.
+    */
+    void swapOversampling (std::unique_ptr<OversamplingStage>& stage) noexcept;
+    int getLatencySamples() const noexcept     { return oversampling != nullptr ? oversampling->latencySamples : 0; }
+
+    /** Bytes this DSP has allocated for itself: filter state, schedules, scratch
+        buffers and the oversampler. The shared tables aren't counted.
+    */
+    size_t getMemoryUsage() const noexcept;
+
+    /** The curve used while settings.curve is user. The caller owns it, and swaps
+        it under the callback lock.
+    */
+    void setUserCurve (const UserCurve* newCurve) noexcept     { userCurve = newCurve; }
+
+    /** Processes the first numChannels channels of the buffer in place.
+
+        Returns false if the block was skipped instead: the input was silent and
+        everything inside the chain had already decayed, so the output is silence.
+    */
+    bool process (juce::AudioBuffer<SampleType>& buffer, int numChannels,
+                  const OverDriveSettings& settings, OverDrivePipeline pipeline) noexcept;
+
+    /** Peak and RMS straight after the drive stage in the last process() call,
+        across all channels. Only measured while settings.meterDrive is set.
+    */
+    LevelReading getDriveLevel() const noexcept     { return driveMeter.getReading(); }
+
+    /** How long the HPF and LPF, the multiband crossovers and the diode
+        clipper's filters take to ring down by the silence threshold with these
+        settings, not counting any oversampling latency.
+    */
+    static double getFilterTailSeconds (const OverDriveSettings& settings) noexcept;
+
+    /** Magnitude response of the HPF and LPF in series at these cutoffs and slopes. */
+    static double getFilterResponse (const OverDriveSettings& settings, double sampleRate, double frequencyHz) noexcept;
+
+private:
+    using Block = PipelineBlock<SampleType>;
+
+    void processChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample, int numSamples, OverDrivePipeline pipeline) noexcept;
+
+    template <typename Shaper>
+    void processChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample, const Block& block,
+                       OverDrivePipeline pipeline, const Shaper& shaper) noexcept;
+
+    template <typename Shaper>
+    void processReferenceChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample, const Block& block, const Shaper& shaper) noexcept;
+
+    template <typename Shaper>
+    void processMultibandChunk (juce::AudioBuffer<SampleType>& buffer, int numChannels, int startSample, const Block& block, const Shaper& shaper) noexcept;
+
+    // The HPF and LPF on the wet signal, then the mix back into the dry
+    void filterAndMix (juce::dsp::AudioBlock<SampleType> dryBlock, juce::dsp::AudioBlock<SampleType> wetBlock, const Block& block) noexcept;
+
+    Block preparePipelineBlock (int numSamples) noexcept;
+    typename Block::FilterCoefficients makeFilterCoefficients (float highPassPosition, float lowPassPosition) const noexcept;
+    void setFilterSlopes (const OverDriveSettings& settings) noexcept;
+
+    template <typename Shaper>
+    void saturate (const Shaper& shaper, int channel, const SampleType* input, SampleType* output, int numSamples, SampleType drive) noexcept;
+
+    bool isSilent (const juce::AudioBuffer<SampleType>& buffer, int numChannels) const noexcept;
+    bool hasDecayed() const noexcept;
+    void clearState() noexcept;
+
+    // Input and filter state below this (-100 dB) count as silence
+    static constexpr SampleType silenceThreshold = (SampleType) 1.0e-5;
+
+    juce::dsp::ProcessSpec spec {};
+
+    // Per-sample smoothing of the continuous parameters
+    juce::SmoothedValue<float> driveSmoothed;
+    juce::SmoothedValue<float> gainSmoothed;
+    juce::SmoothedValue<float> mixSmoothed;
+
+    // Cutoffs are smoothed as positions in cutoffTable: linear there is multiplicative in Hz
+    juce::SmoothedValue<float> highPassSmoothed;
+    juce::SmoothedValue<float> lowPassSmoothed;
+    std::shared_ptr<const CutoffTable> cutoffTable;
+
+    // Filter coefficients are recalculated at most once per this many samples while a cutoff moves
+    static constexpr int minimumFilterUpdateInterval = 8;
+    int filterUpdateInterval = 16;
+
+    int highPassSections = 1, lowPassSections = 1;
+    FilterAlignment filterAlignment = FilterAlignment::butterworth;
+
+    WaveshaperCurve curve = WaveshaperCurve::tanh;
+    SaturationKernel saturation;                            // The tanh curve
+    AntiderivativeSaturation<SampleType> antialiasing;     // Replaces the kernel while ADAA is on
+    DiodeClipper<SampleType> diodeClipper;                  // Replaces both while it is the drive model
+    std::shared_ptr<const DiodeClipperTable> clipperTable;  // For the host rate; an oversampling stage brings its own
+    DriveModel driveModel = DriveModel::waveshaper;
+    const UserCurve* userCurve = nullptr;
+    MultibandDrive<SampleType> multiband;
+
+    bool meterDrive = false;
+    LevelMeter<SampleType> driveMeter;
+
+    // Filter state lives outside the filters so the fused path can keep it in registers
+    std::vector<TPTCascadeState<SampleType>> highPassState;
+    std::vector<TPTCascadeState<SampleType>> lowPassState;
+    std::vector<typename Block::FilterCoefficients> coefficientSchedule;
+    typename Block::FilterCoefficients steadyCoefficients;
+    bool steadyCoefficientsValid = false;     // Cleared when the slopes change, so the steady set is made again
+
+    // Scratch storage, sized in prepare so process never allocates
+    juce::AudioBuffer<SampleType> wetBuffer;
+    juce::AudioBuffer<SampleType> rampBuffer;
+    juce::AudioBuffer<SampleType> laneScratch;    // Pads a partial group of channels out to a full SIMD register
+
+    // Null while oversampling is off, so that mode costs nothing
+    std::unique_ptr<OversamplingStage> oversampling;
+
+    // Consecutive silent input samples, and whether the chain is currently being skipped
+    int silentSamples = 0;
+    bool idle = false;
+};
@@ -7,19 +7,15 @@
 */
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "underratedFXLookAndFeel.h"
 #include "BinaryData.h"  // Include BinaryData
 
-// Create a global instance of the custom LookAndFeel
-static UnderratedFXLookAndFeel customLookAndFeel;
-
 OverDrive4AudioProcessorEditor::OverDrive4AudioProcessorEditor (OverDrive4AudioProcessor& p)
-    : AudioProcessorEditor (&p), processor (p)
+    : AudioProcessorEditor (&p), processor (p), curveEditor (p), meterPanel (p), spectrumView (p), presetBar (p), multibandPanel (p)
 {
     driveSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
     driveSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 50, 20);
     driveSlider.setColour(juce::Slider::thumbColourId, juce::Colours::red); // Example of setting a specific colour
-    driveSlider.setLookAndFeel(&customLookAndFeel);
+    driveSlider.setLookAndFeel(&customLookAndFeel.get());
     driveSlider.addListener(this); // Add listener for rounding
     addAndMakeVisible(driveSlider);
 
@@ -27,7 +23,7 @@ OverDrive4AudioProcessorEditor::OverDrive4AudioProcessorEditor (OverDrive4AudioP
     gainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 50, 20);
     gainSlider.setColour(juce::Slider::textBoxOutlineColourId, juce::Colours::transparentBlack);
     gainSlider.setTextValueSuffix(" dB");
-    gainSlider.setLookAndFeel(&customLookAndFeel);
+    gainSlider.setLookAndFeel(&customLookAndFeel.get());
     gainSlider.addListener(this); // Add listener for rounding
     addAndMakeVisible(gainSlider);
 
@@ -36,7 +32,7 @@ OverDrive4AudioProcessorEditor::OverDrive4AudioProcessorEditor (OverDrive4AudioP
     mixSlider.setColour(juce::Slider::textBoxOutlineColourId, juce::Colours::transparentBlack);
     mixSlider.setTextValueSuffix(" %");
     mixSlider.setValue(50.0f);
-    mixSlider.setLookAndFeel(&customLookAndFeel);
+    mixSlider.setLookAndFeel(&customLookAndFeel.get());
     mixSlider.addListener(this); // Add listener for rounding
     addAndMakeVisible(mixSlider);
 
@@ -47,7 +43,7 @@ OverDrive4AudioProcessorEditor::OverDrive4AudioProcessorEditor (OverDrive4AudioP
     highPassFreqSlider.setRange(20.0f, 20000.0f, 1.0f); // Set interval to 1 for precise control
     highPassFreqSlider.setSkewFactorFromMidPoint(500.0); // Set skew factor for logarithmic scale
     highPassFreqSlider.setNumDecimalPlacesToDisplay(0);
-    highPassFreqSlider.setLookAndFeel(&customLookAndFeel);
+    highPassFreqSlider.setLookAndFeel(&customLookAndFeel.get());
     highPassFreqSlider.addListener(this); // Add listener for rounding
     addAndMakeVisible(highPassFreqSlider);
 
@@ -57,7 +53,7 @@ OverDrive4AudioProcessorEditor::OverDrive4AudioProcessorEditor (OverDrive4AudioP
     lowPassFreqSlider.setTextValueSuffix(" Hz");
     lowPassFreqSlider.setRange(20.0f, 20000.0f, 1.0f); // Set interval to 1 for precise control
     lowPassFreqSlider.setSkewFactorFromMidPoint(500.0); // Set skew factor for logarithmic scale
-    lowPassFreqSlider.setLookAndFeel(&customLookAndFeel);
+    lowPassFreqSlider.setLookAndFeel(&customLookAndFeel.get());
     lowPassFreqSlider.addListener(this); // Add listener for rounding
     addAndMakeVisible(lowPassFreqSlider);
 
@@ -65,48 +61,54 @@ OverDrive4AudioProcessorEditor::OverDrive4AudioProcessorEditor (OverDrive4AudioP
     driveLabel.attachToComponent(&driveSlider, false);
     driveLabel.setJustificationType(juce::Justification::centred);
     driveLabel.setFont(juce::Font(18.0f, juce::Font::bold));
-    driveLabel.setLookAndFeel(&customLookAndFeel);
+    driveLabel.setLookAndFeel(&customLookAndFeel.get());
     addAndMakeVisible(driveLabel);
 
     gainLabel.setText("Gain", juce::dontSendNotification);
     gainLabel.attachToComponent(&gainSlider, false);
     gainLabel.setJustificationType(juce::Justification::centred);
     gainLabel.setFont(juce::Font(18.0f, juce::Font::bold));
-    gainLabel.setLookAndFeel(&customLookAndFeel);
+    gainLabel.setLookAndFeel(&customLookAndFeel.get());
     addAndMakeVisible(gainLabel);
 
     mixLabel.setText("Mix", juce::dontSendNotification);
     mixLabel.attachToComponent(&mixSlider, false);
     mixLabel.setJustificationType(juce::Justification::centred);
     mixLabel.setFont(juce::Font(18.0f, juce::Font::bold));
-    mixLabel.setLookAndFeel(&customLookAndFeel);
+    mixLabel.setLookAndFeel(&customLookAndFeel.get());
     addAndMakeVisible(mixLabel);
 
     highPassFreqLabel.setText("HPF Freq", juce::dontSendNotification);
     highPassFreqLabel.attachToComponent(&highPassFreqSlider, false);
     highPassFreqLabel.setJustificationType(juce::Justification::centred);
     highPassFreqLabel.setFont(juce::Font(18.0f, juce::Font::bold));
-    highPassFreqLabel.setLookAndFeel(&customLookAndFeel);
+    highPassFreqLabel.setLookAndFeel(&customLookAndFeel.get());
     addAndMakeVisible(highPassFreqLabel);
 
     lowPassFreqLabel.setText("LPF Freq", juce::dontSendNotification);
     lowPassFreqLabel.attachToComponent(&lowPassFreqSlider, false);
     lowPassFreqLabel.setJustificationType(juce::Justification::centred);
     lowPassFreqLabel.setFont(juce::Font(18.0f, juce::Font::bold));
-    lowPassFreqLabel.setLookAndFeel(&customLookAndFeel);
+    lowPassFreqLabel.setLookAndFeel(&customLookAndFeel.get());
     addAndMakeVisible(lowPassFreqLabel);
 
     filterLabel.setText("Filter", juce::dontSendNotification); // Initialize the filter label
     filterLabel.setFont(juce::Font(22.0f, juce::Font::bold)); // Set the font size and style
     filterLabel.setJustificationType(juce::Justification::centred);
-    filterLabel.setLookAndFeel(&customLookAndFeel);
+    filterLabel.setLookAndFeel(&customLookAndFeel.get());
     addAndMakeVisible(filterLabel);
     
     overdriveLabel.setText("OverDrive", juce::dontSendNotification);
     overdriveLabel.setFont(juce::Font(32.0f, juce::Font::bold));
     overdriveLabel.setJustificationType(juce::Justification::centred);
-    overdriveLabel.setLookAndFeel(&customLookAndFeel);
+    overdriveLabel.setLookAndFeel(&customLookAndFeel.get());
     addAndMakeVisible(overdriveLabel);
+
+    addAndMakeVisible(curveEditor);
+    addAndMakeVisible(meterPanel);
+    addAndMakeVisible(spectrumView);
+    addAndMakeVisible(presetBar);
+    addAndMakeVisible(multibandPanel);
     
     driveAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(processor.parameters, "DRIVE", driveSlider);
     gainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(processor.parameters, "GAIN", gainSlider);
@@ -120,7 +122,7 @@ OverDrive4AudioProcessorEditor::OverDrive4AudioProcessorEditor (OverDrive4AudioP
     logoImage = juce::ImageCache::getFromMemory(BinaryData::Colour_ufxlogo_nobackground_png, BinaryData::Colour_ufxlogo_nobackground_pngSize);
     
     //Resizable false
-    setSize (600, 400);
+    setSize (600, 400 + bandsHeight + analyzerHeight);
     setResizable(false, false);
 }
 
@@ -128,6 +130,33 @@ OverDrive4AudioProcessorEditor::~OverDrive4AudioProcessorEditor() {}
 
 void OverDrive4AudioProcessorEditor::paint (juce::Graphics& g)
 {
+    frameStartTicks = juce::Time::getHighResolutionTicks();
+
+    // Everything drawn here is static, so it is only rendered again when the size or display scale changes
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (backgroundLayer.isNull() || scale != backgroundLayerScale)
+        renderBackgroundLayer(scale);
+
+    g.drawImage(backgroundLayer, getLocalBounds().toFloat());
+}
+
+void OverDrive4AudioProcessorEditor::paintOverChildren (juce::Graphics&)
+{
+    const auto frameMilliseconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - frameStartTicks) * 1000.0;
+    averageFrameMilliseconds += 0.1 * (frameMilliseconds - averageFrameMilliseconds);
+    meterPanel.setFrameTime(averageFrameMilliseconds, frameMilliseconds);
+}
+
+void OverDrive4AudioProcessorEditor::renderBackgroundLayer (float scale)
+{
+    backgroundLayer = juce::Image(juce::Image::ARGB, juce::jmax(1, juce::roundToInt(getWidth() * scale)),
+                                  juce::jmax(1, juce::roundToInt(getHeight() * scale)), true);
+    backgroundLayerScale = scale;
+
+    juce::Graphics g(backgroundLayer);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     g.fillAll (juce::Colour::fromRGB(85, 85, 85));
 
     // Draw the rounded rectangle outline
@@ -141,30 +170,47 @@ void OverDrive4AudioProcessorEditor::paint (juce::Graphics& g)
     }
 
     // Draw the filter background with original color and shadow overlays
-    customLookAndFeel.drawFilterBackground(g, bottomRectangle);
+    customLookAndFeel->drawFilterBackground(g, bottomRectangle);
 }
 
 void OverDrive4AudioProcessorEditor::resized()
 {
-    driveSlider.setBounds (getWidth() * 0.08, getHeight() * 0.3, 120, 120);
-    gainSlider.setBounds (getWidth() * 0.395, getHeight() * 0.20, 120, 120);
-    mixSlider.setBounds (getWidth() * 0.72, getHeight() * 0.3, 120, 120);
-    highPassFreqSlider.setBounds (getWidth() * 0.33, getHeight() * 0.75, 75, 75);
-    lowPassFreqSlider.setBounds (getWidth() * 0.54, getHeight() * 0.75, 75, 75);
+    // The band knobs and the analyzer take strips along the bottom; everything else is laid out above them
+    auto mainHeight = getHeight() - analyzerHeight - bandsHeight;
+    multibandPanel.setBounds (margin, mainHeight, getWidth() - 2 * margin, bandsHeight - margin);
+    spectrumView.setBounds (margin, mainHeight + bandsHeight, getWidth() - 2 * margin, analyzerHeight - margin);
+
+    driveSlider.setBounds (getWidth() * 0.08, mainHeight * 0.3, 120, 120);
+    gainSlider.setBounds (getWidth() * 0.395, mainHeight * 0.20, 120, 120);
+    mixSlider.setBounds (getWidth() * 0.72, mainHeight * 0.3, 120, 120);
+    highPassFreqSlider.setBounds (getWidth() * 0.33, mainHeight * 0.75, 75, 75);
+    lowPassFreqSlider.setBounds (getWidth() * 0.54, mainHeight * 0.75, 75, 75);
+
+    // Curve selector and plot in the bottom left corner, beside the filter panel
+    curveEditor.setBounds (margin, mainHeight * 0.64, getWidth() * 0.28 - margin, mainHeight * 0.36 - margin);
+
+    // Meters in the bottom right corner, mirroring the curve editor
+    meterPanel.setBounds (getWidth() * 0.72, mainHeight * 0.64, getWidth() * 0.28 - margin, mainHeight * 0.36 - margin);
      
     // Calculate the bounds for the bottom rectangle
     auto width = getWidth() * 0.4f; // Width increased to 40% of the total width
-    auto height = getHeight() * 0.45f; // Height set to 45% of the total height
+    auto height = mainHeight * 0.45f; // Height set to 45% of the total height
     auto x = (getWidth() - width) / 2;
-    auto y = getHeight() - height - 10;
+    auto y = mainHeight - height - 10;
     bottomRectangle.setBounds(x, y, width, height);
     
     // Set bounds for the filter label
     filterLabel.setBounds(x, y + 10, width, 22);
-    overdriveLabel.setBounds((getWidth() / 2) - 85, getHeight() * 0.025, 170, 30);
+    overdriveLabel.setBounds((getWidth() / 2) - 85, mainHeight * 0.025, 170, 30);
     
     // Set bounds for the logo image in the top corner
     logoBounds.setBounds(5, 5, 130, 40); // Adjust the size and position as needed
+
+    // Presets in the opposite corner
+    presetBar.setBounds(getWidth() * 0.66, 12, getWidth() * 0.34 - margin, 24);
+
+    // The layout changed, so the background layer is rendered again on the next paint
+    backgroundLayer = {};
 }
 
 void OverDrive4AudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
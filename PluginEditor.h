@@ -9,6 +9,12 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "CurveEditor.h"
+#include "MeterPanel.h"
+#include "SpectrumView.h"
+#include "PresetBar.h"
+#include "MultibandPanel.h"
+#include "UnderratedFXLookAndFeel.h"
 
 
 class OverDrive4AudioProcessorEditor  : public juce::AudioProcessorEditor, private juce::Slider::Listener
@@ -18,11 +24,16 @@ public:
     ~OverDrive4AudioProcessorEditor() override;
 
     void paint (juce::Graphics&) override;
+    void paintOverChildren (juce::Graphics&) override;
     void resized() override;
 
 private:
     void sliderValueChanged(juce::Slider* slider) override;
     void roundSliderValue(juce::Slider* slider, float interval);
+    void renderBackgroundLayer(float scale);
+
+    // One LookAndFeel (and knob cache) for every open editor; declared first so it outlives the components using it
+    juce::SharedResourcePointer<UnderratedFXLookAndFeel> customLookAndFeel;
 
     OverDrive4AudioProcessor& processor;
 
@@ -33,6 +44,21 @@ private:
     juce::Slider highPassFreqSlider;
     juce::Slider lowPassFreqSlider;
 
+    //Curve selector and display
+    CurveEditor curveEditor;
+
+    //Levels and CPU load
+    MeterPanel meterPanel;
+
+    //Output spectrum and filter response, along the bottom
+    SpectrumView spectrumView;
+
+    //Factory and user presets, top right
+    PresetBar presetBar;
+
+    //Band count and per-band knobs, above the analyzer
+    MultibandPanel multibandPanel;
+
     //Labels
     juce::Label driveLabel;
     juce::Label gainLabel;
@@ -46,6 +72,8 @@ private:
     const int margin = 10;
     const int minWidth = 400;
     const int minHeight = 300;
+    const int analyzerHeight = 130;
+    const int bandsHeight = 90;
     
     //ValueTreeStates
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> driveAttachment;
@@ -61,5 +89,13 @@ private:
     juce::Image logoImage;
     juce::Rectangle<int> logoBounds;
 
+    //Background, filter panel and logo, rendered once per size and display scale
+    juce::Image backgroundLayer;
+    float backgroundLayerScale = 0.0f;
+
+    //Frame time: from the start of paint() to the end of paintOverChildren(), children included
+    juce::int64 frameStartTicks = 0;
+    double averageFrameMilliseconds = 0.0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OverDrive4AudioProcessorEditor)
 };
@@ -6,9 +6,22 @@
   ==============================================================================
 */
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "AudioThreadAllocationTrap.h"
 #include <cmath>
 
+// Set to 1 when the processor is built into a command-line tool such as the batch renderer
+#ifndef OVERDRIVE_HEADLESS
+ #define OVERDRIVE_HEADLESS 0
+#endif
+
+#if ! OVERDRIVE_HEADLESS
+ #include "PluginEditor.h"
+#endif
+
+#ifndef JucePlugin_Name
+ #define JucePlugin_Name "OverDrive4"
+#endif
+
 OverDrive4AudioProcessor::OverDrive4AudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
      : AudioProcessor (BusesProperties()
@@ -22,115 +35,337 @@ OverDrive4AudioProcessor::OverDrive4AudioProcessor()
                        parameters(*this, nullptr, "PARAMETERS", createParameterLayout())
 #endif
 {
+    // Cache the parameter handles once, so the audio thread never looks them up by ID
+    for (int i = 0; i < PresetParameters::numParameters; ++i)
+    {
+        parameterValues[(size_t) i] = parameters.getRawParameterValue (PresetParameters::ids[i]);
+
+        // Presets fill in anything they don't store from these defaults, and the core clamps to these ranges, so they have to match the layout
+        const auto* parameter = parameters.getParameter (PresetParameters::ids[i]);
+        const auto& range = PresetParameters::ranges[i];
+        jassert (parameter != nullptr && juce::approximatelyEqual (parameter->convertFrom0to1 (parameter->getDefaultValue()), PresetParameters::defaults[i]));
+        jassert (parameter != nullptr && juce::approximatelyEqual (parameter->getNormalisableRange().start, range.minimum)
+                                      && juce::approximatelyEqual (parameter->getNormalisableRange().end, range.maximum)
+                                      && (dynamic_cast<const juce::AudioParameterChoice*> (parameter) != nullptr) == range.isChoice);
+        juce::ignoreUnused (parameter, range);
+    }
 }
 
-OverDrive4AudioProcessor::~OverDrive4AudioProcessor() {}
+OverDrive4AudioProcessor::~OverDrive4AudioProcessor()
+{
+    cancelPendingUpdate();
+}
 
 const juce::String OverDrive4AudioProcessor::getName() const { return JucePlugin_Name; }
 
 bool OverDrive4AudioProcessor::acceptsMidi() const { return false; }
 bool OverDrive4AudioProcessor::producesMidi() const { return false; }
 bool OverDrive4AudioProcessor::isMidiEffect() const { return false; }
-double OverDrive4AudioProcessor::getTailLengthSeconds() const { return 0.0; }
+double OverDrive4AudioProcessor::getTailLengthSeconds() const
+{
+    return core.getTailLengthSeconds (readSettings());
+}
+
+bool OverDrive4AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+    // Anything from mono up to maxChannels (e.g. 5.1, 7.1.4, 3rd order ambisonics), as long as the output matches the input
+    const auto mainOutput = layouts.getMainOutputChannelSet();
+
+    if (mainOutput.isDisabled() || mainOutput.size() > maxChannels)
+        return false;
+
+    return layouts.getMainInputChannelSet() == mainOutput;
+}
+
+int OverDrive4AudioProcessor::getNumPrograms() { return juce::jmax (1, presetBank->getNumPresets()); }
+int OverDrive4AudioProcessor::getCurrentProgram() { return currentProgram.load(); }
+
+void OverDrive4AudioProcessor::setCurrentProgram (int index)
+{
+    // The snapshot is already built, so the audio thread just picks up the pointer.
+    // Hosts may call this from any thread; the parameters are caught up on the message thread.
+    const auto* preset = presetBank->getPreset (index);
 
-int OverDrive4AudioProcessor::getNumPrograms() { return 1; }
-int OverDrive4AudioProcessor::getCurrentProgram() { return 0; }
-void OverDrive4AudioProcessor::setCurrentProgram (int index) {}
-const juce::String OverDrive4AudioProcessor::getProgramName (int index) { return {}; }
-void OverDrive4AudioProcessor::changeProgramName (int index, const juce::String& newName) {}
+    if (preset == nullptr)
+        return;
+
+    currentProgram = index;
+    presetOverride.store (preset, std::memory_order_release);
+    triggerAsyncUpdate();
+}
+
+const juce::String OverDrive4AudioProcessor::getProgramName (int index)
+{
+    const auto* preset = presetBank->getPreset (index);
+    return preset != nullptr ? preset->name : juce::String();
+}
+
+void OverDrive4AudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+    if (presetBank->renameUserPreset (index, newName))
+        updateHostDisplay (ChangeDetails().withProgramChanged (true));
+}
+
+int OverDrive4AudioProcessor::saveUserPreset (const juce::String& name)
+{
+    const auto* preset = presetOverride.load();
+    const auto index = preset != nullptr ? presetBank->saveUserPreset (name, preset->values, preset->userCurve)
+                                         : presetBank->saveUserPreset (name, readParameterValues(), getUserCurve());
+
+    if (index >= 0)
+    {
+        currentProgram = index;
+        updateHostDisplay (ChangeDetails().withProgramChanged (true));
+    }
+
+    return index;
+}
+
+bool OverDrive4AudioProcessor::deleteUserPreset (int index)
+{
+    if (! presetBank->removeUserPreset (index))
+        return false;
+
+    // The sound doesn't change; the selection just moves back to the default
+    if (currentProgram == index)
+        currentProgram = 0;
+    else if (currentProgram > index)
+        --currentProgram;
+
+    updateHostDisplay (ChangeDetails().withProgramChanged (true));
+    return true;
+}
 
 void OverDrive4AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = getTotalNumInputChannels();
+    OVERDRIVE_TRACE_SPAN (core.getTraceBuffer(), "prepareToPlay");
 
-    highPassFilter.prepare(spec);
-    highPassFilter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
-    highPassFilter.setCutoffFrequency(20.0f); // Initial value
-    highPassFilter.setResonance(0.7f); // Lower resonance for gentler slope
+    // The host chooses the precision before calling prepareToPlay
+    cancelOversamplingUpdate();
+    core.setRenderingOffline (isNonRealtime());
+    core.prepare (sampleRate, samplesPerBlock, juce::jmax (1, getTotalNumInputChannels()), isUsingDoublePrecision(), readSettings());
+    setLatencySamples (core.getLatencySamples());
 
-    lowPassFilter.prepare(spec);
-    lowPassFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    lowPassFilter.setCutoffFrequency(20000.0f); // Initial value
-    lowPassFilter.setResonance(0.7f); // Lower resonance for gentler slope
+    spectrumAnalyzer.prepare (sampleRate);
 }
 
-void OverDrive4AudioProcessor::releaseResources() {}
+void OverDrive4AudioProcessor::releaseResources()
+{
+    cancelOversamplingUpdate();
+    core.release();
+}
 
-void OverDrive4AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void OverDrive4AudioProcessor::setNonRealtime (bool isNonRealtime) noexcept
 {
-    auto drive = parameters.getRawParameterValue("DRIVE")->load();
-    auto gain = juce::Decibels::decibelsToGain(parameters.getRawParameterValue("GAIN")->load());
-    auto mix = parameters.getRawParameterValue("MIX")->load() / 100.0f; // Convert mix to 0.0 - 1.0 range
+    AudioProcessor::setNonRealtime (isNonRealtime);
 
-    auto highPassFreq = parameters.getRawParameterValue("HPF_FREQ")->load();
-    auto lowPassFreq = parameters.getRawParameterValue("LPF_FREQ")->load();
+    // Offline bounces run at the render tier. Some hosts (JUCE's VST2 wrapper among them) call this
+    // from the audio thread, so the new oversampling stage is left to the message thread like any other.
+    core.setRenderingOffline (isNonRealtime);
+    triggerAsyncUpdate();
+}
 
-    highPassFreq = std::round(highPassFreq / 10.0f) * 10.0f;
-    lowPassFreq = std::round(lowPassFreq / 10.0f) * 10.0f;
+MemoryReport OverDrive4AudioProcessor::getMemoryReport() const
+{
+    // The core's report, plus what the plugin side holds
+    auto report = core.getMemoryReport();
+    report.instanceBytes += sizeof (*this) - sizeof (OverDriveCore) + spectrumAnalyzer.getMemoryUsage();
+    report.sharedBytes += presetBank->getMemoryUsage() + spectrumAnalyzer.getSharedMemoryUsage();
+    return report;
+}
 
-    highPassFilter.setCutoffFrequency(highPassFreq);
-    lowPassFilter.setCutoffFrequency(lowPassFreq);
+OverDriveSettings OverDrive4AudioProcessor::readSettings() const noexcept
+{
+    if (const auto* preset = presetOverride.load (std::memory_order_acquire))
+        return preset->settings;
 
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
+    return PresetParameters::toSettings (readParameterValues());
+}
 
-    juce::AudioBuffer<float> wetBuffer;
-    wetBuffer.makeCopyOf(buffer);
+ParameterValues OverDrive4AudioProcessor::readParameterValues() const noexcept
+{
+    ParameterValues values;
+
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = parameterValues[i]->load();
+
+    return values;
+}
 
-    for (int channel = 0; channel < getTotalNumInputChannels(); ++channel)
+//==============================================================================
+void OverDrive4AudioProcessor::setUserCurve (const UserCurve& newCurve)
+{
+    core.setUserCurve (newCurve);
+}
+
+UserCurve OverDrive4AudioProcessor::getUserCurve() const
+{
+    return core.getUserCurve();
+}
+
+void OverDrive4AudioProcessor::applyValues (const ParameterValues& values, const UserCurve& curve)
+{
+    for (int i = 0; i < PresetParameters::numParameters; ++i)
     {
-        auto* channelData = wetBuffer.getWritePointer (channel);
+        auto* parameter = parameters.getParameter (PresetParameters::ids[i]);
+        parameter->setValueNotifyingHost (parameter->convertTo0to1 (values[(size_t) i]));
+    }
+
+    setUserCurve (curve);
+}
 
-        for (int sample = 0; sample < wetBuffer.getNumSamples(); ++sample)
-        {
-            // Apply overdrive effect
-            float cleanSignal = channelData[sample];
-            float overdrivenSignal = std::tanh(drive * cleanSignal) * gain;
+void OverDrive4AudioProcessor::handleAsyncUpdate()
+{
+    // Catch the parameters up with a newly selected preset, then let the audio thread go back to them
+    if (auto* preset = presetOverride.load())
+    {
+        applyValues (preset->values, preset->userCurve);
 
-            channelData[sample] = overdrivenSignal;
-        }
+        // Unless another preset was selected in the meantime, which then gets its own update
+        presetOverride.compare_exchange_strong (preset, nullptr);
+        sendChangeMessage();
     }
 
-    // Apply high-pass filter
-    juce::dsp::AudioBlock<float> wetBlock(wetBuffer);
-    juce::dsp::ProcessContextReplacing<float> wetContext(wetBlock);
-    highPassFilter.process(wetContext);
+    // A new oversampling stage allocates, so the core leaves it to this thread. setNonRealtime
+    // changes the tier without a block having run yet, so the settings are checked as well.
+    if (core.needsUpdate() || (core.isPrepared() && core.needsUpdate (readSettings())))
+        setLatencySamples (core.update (readSettings()));
+
+    // Cleared after the update, so the audio thread posts again only for a change it hasn't made.
+    // One that slips in meanwhile still shows in needsUpdate() on the next block.
+    oversamplingUpdatePosted.store (false, std::memory_order_release);
+}
+
+void OverDrive4AudioProcessor::cancelOversamplingUpdate()
+{
+    // prepare and release build or drop the oversampling stage themselves, so a pending rebuild can go.
+    // A selected preset still has to reach the parameters, or presetOverride would hide them for good.
+    cancelPendingUpdate();
+
+    // Otherwise processSamples would take the cancelled update as still posted and never post another
+    oversamplingUpdatePosted.store (false, std::memory_order_release);
+
+    if (presetOverride.load() != nullptr)
+        triggerAsyncUpdate();
+}
+
+//==============================================================================
+bool OverDrive4AudioProcessor::supportsDoublePrecisionProcessing() const { return true; }
+
+void OverDrive4AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples (buffer);
+}
+
+void OverDrive4AudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples (buffer);
+}
+
+template <typename SampleType>
+void OverDrive4AudioProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer)
+{
+    OVERDRIVE_TRACE_SPAN (core.getTraceBuffer(), "processBlock");
+
+    // The core has a trap of its own for other hosts; this one covers the plugin's side of the block too
+    ScopedAudioThreadAllocationTrap allocationTrap;
+
+    for (auto channel = getTotalNumInputChannels(); channel < getTotalNumOutputChannels(); ++channel)
+        buffer.clear (channel, 0, buffer.getNumSamples());
+
+    const auto measure = telemetryEnabled.load (std::memory_order_relaxed);
+    const auto startTicks = measure ? juce::Time::getHighResolutionTicks() : 0;
+    BlockTelemetry telemetry;
+
+    if (measure)
+        telemetry.input = measureLevel (buffer);
 
-    // Apply low-pass filter
-    lowPassFilter.process(wetContext);
+    // A newly selected preset stands in for the parameters, user curve included, until they have caught up
+    const auto* preset = presetOverride.load (std::memory_order_acquire);
+    auto settings = preset != nullptr ? preset->settings : PresetParameters::toSettings (readParameterValues());
+    settings.meterDrive = measure;
 
-    // Apply wet/dry mix
-    for (int channel = 0; channel < getTotalNumInputChannels(); ++channel)
+    core.process (buffer, getTotalNumInputChannels(), settings, preset != nullptr ? &preset->userCurve : nullptr);
+
+    // Changing the oversampling mode allocates, so it is handed over to the message thread.
+    // Posting can lock or allocate on some platforms, so it happens once per change, not every block.
+    if (core.needsUpdate() && ! oversamplingUpdatePosted.exchange (true, std::memory_order_acq_rel))
+        triggerAsyncUpdate();
+
+    if (measure)
     {
-        auto* dryChannelData = buffer.getWritePointer(channel);
-        auto* wetChannelData = wetBuffer.getWritePointer(channel);
+        telemetry.drive = core.getDriveLevel();
+        telemetry.output = measureLevel (buffer);
+        telemetry.numSamples = buffer.getNumSamples();
+
+        const auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks);
+        const auto blockSeconds = buffer.getNumSamples() / juce::jmax (1.0, getSampleRate());
+        telemetry.load = (float) (elapsedSeconds / blockSeconds);
 
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            dryChannelData[sample] = dryChannelData[sample] * (1.0f - mix) + wetChannelData[sample] * mix;
-        }
+        // Dropped if the editor has fallen behind
+        telemetryQueue.push (telemetry);
     }
+
+    if (spectrumAnalyzer.isActive())
+        spectrumAnalyzer.push (buffer, getTotalNumOutputChannels());
 }
 
+template <typename SampleType>
+LevelReading OverDrive4AudioProcessor::measureLevel (const juce::AudioBuffer<SampleType>& buffer) const noexcept
+{
+    const auto numChannels = juce::jmin (getTotalNumInputChannels(), buffer.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0 || numSamples == 0)
+        return {};
+
+    LevelReading level;
+    double sumOfSquares = 0.0;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        level.peak = juce::jmax (level.peak, (float) buffer.getMagnitude (channel, 0, numSamples));
+        const auto rms = (double) buffer.getRMSLevel (channel, 0, numSamples);
+        sumOfSquares += rms * rms;
+    }
+
+    level.rms = (float) std::sqrt (sumOfSquares / numChannels);
+    return level;
+}
+
+#if OVERDRIVE_HEADLESS
+bool OverDrive4AudioProcessor::hasEditor() const { return false; }
+juce::AudioProcessorEditor* OverDrive4AudioProcessor::createEditor() { return nullptr; }
+#else
 bool OverDrive4AudioProcessor::hasEditor() const { return true; }
 juce::AudioProcessorEditor* OverDrive4AudioProcessor::createEditor() { return new OverDrive4AudioProcessorEditor (*this); }
+#endif
 
 void OverDrive4AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    juce::MemoryOutputStream stream(destData, true);
-    parameters.state.writeToStream(stream);
+    // A preset that hasn't reached the parameters yet is what's playing, so that's what is saved
+    PresetFormat::Contents contents;
+    const auto* preset = presetOverride.load();
+    contents.values = preset != nullptr ? preset->values : readParameterValues();
+    contents.userCurve = preset != nullptr ? preset->userCurve : getUserCurve();
+    contents.program = currentProgram.load();
+
+    juce::MemoryOutputStream stream (destData, true);
+    PresetFormat::write (stream, contents);
 }
 
 void OverDrive4AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    juce::ValueTree tree = juce::ValueTree::readFromData(data, sizeInBytes);
-    if (tree.isValid())
-    {
-        parameters.state = tree;
-    }
+    // Reads the current format, any older version, or the ValueTree state from before it
+    PresetFormat::Contents contents;
+
+    if (! PresetFormat::read (data, (size_t) juce::jmax (0, sizeInBytes), contents))
+        return;
+
+    presetOverride = nullptr;
+    applyValues (contents.values, contents.userCurve);
+    currentProgram = juce::jlimit (0, getNumPrograms() - 1, contents.program);
+    sendChangeMessage();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout OverDrive4AudioProcessor::createParameterLayout()
@@ -142,6 +377,34 @@ juce::AudioProcessorValueTreeState::ParameterLayout OverDrive4AudioProcessor::cr
     params.push_back(std::make_unique<juce::AudioParameterFloat>("MIX", "Mix", 0.0f, 100.0f, 50.0f));
     params.push_back(std::make_unique<juce::AudioParameterFloat>("HPF_FREQ", "High-Pass Frequency", 20.0f, 20000.0f, 20.0f));
     params.push_back(std::make_unique<juce::AudioParameterFloat>("LPF_FREQ", "Low-Pass Frequency", 20.0f, 20000.0f, 20000.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("SAT_ACCURACY", "Saturation Accuracy", juce::StringArray { "Fast", "Balanced", "Accurate" }, 2));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("OVERSAMPLING", "Oversampling", juce::StringArray { "Off", "2x", "4x", "8x" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("OS_FILTER", "Oversampling Filter", juce::StringArray { "IIR (Low Latency)", "FIR (Linear Phase)" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("FILTER_UPDATE", "Filter Update Interval", juce::StringArray { "8 Samples", "16 Samples", "32 Samples" }, 1));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("ANTIALIASING", "Anti-Aliasing", juce::StringArray { "Off", "ADAA 1st Order", "ADAA 2nd Order" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("CURVE", "Curve", juce::StringArray { "Tanh", "Tube", "Soft Clip", "Hard Clip", "Foldback", "User" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("HPF_SLOPE", "High-Pass Slope", juce::StringArray { "12 dB/oct", "24 dB/oct", "36 dB/oct", "48 dB/oct" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("LPF_SLOPE", "Low-Pass Slope", juce::StringArray { "12 dB/oct", "24 dB/oct", "36 dB/oct", "48 dB/oct" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("FILTER_TYPE", "Filter Type", juce::StringArray { "Butterworth", "Linkwitz-Riley" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("BANDS", "Bands", juce::StringArray { "Off", "2 Bands", "3 Bands", "4 Bands" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("XOVER_1", "Crossover 1", 20.0f, 20000.0f, 150.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("XOVER_2", "Crossover 2", 20.0f, 20000.0f, 1000.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("XOVER_3", "Crossover 3", 20.0f, 20000.0f, 5000.0f));
+
+    for (int band = 1; band <= maxBands; ++band)
+    {
+        const auto id = "BAND" + juce::String (band) + "_";
+        const auto name = "Band " + juce::String (band) + " ";
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(id + "DRIVE", name + "Drive", 0.0f, 10.0f, 5.0f));
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(id + "GAIN", name + "Gain", -12.0f, 12.0f, 0.0f));
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(id + "MIX", name + "Mix", 0.0f, 100.0f, 100.0f));
+    }
+
+    // Later parameters go after the ones already shipped, so hosts that address parameters by index still find them
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("QUALITY", "Quality", juce::StringArray { "Custom", "Eco", "Live", "Render" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("BOUNCE_QUALITY", "Bounce Quality", juce::StringArray { "As Selected", "Render" }, 1));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("DRIVE_MODEL", "Drive Model", juce::StringArray { "Waveshaper", "Diode Clipper" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("TONE", "Tone", 0.0f, 100.0f, 50.0f));
 
     return { params.begin(), params.end() };
 }
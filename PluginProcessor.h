@@ -8,8 +8,13 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "OverDriveCore.h"
+#include "SpectrumAnalyzer.h"
+#include "PresetBank.h"
 
-class OverDrive4AudioProcessor : public juce::AudioProcessor
+class OverDrive4AudioProcessor : public juce::AudioProcessor,
+                                 public juce::ChangeBroadcaster,
+                                 private juce::AsyncUpdater
 {
 public:
     OverDrive4AudioProcessor();
@@ -17,8 +22,15 @@ public:
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime (bool isNonRealtime) noexcept override;
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
+
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+    static constexpr int maxChannels = 16;
+    static_assert (maxChannels <= OverDriveCore::maxChannels, "The core can't take this many channels without allocating");
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -42,9 +54,77 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState parameters;
 
+    using Pipeline = OverDrivePipeline;
+    void setPipeline (Pipeline newPipeline) noexcept   { core.setPipeline (newPipeline); }
+
+    /** The curve drawn in the editor, used while the Curve parameter is User.
+        Message thread only: the core swaps the new curve in under its lock.
+    */
+    void setUserCurve (const UserCurve& newCurve);
+    UserCurve getUserCurve() const;
+
+    /** Factory and user presets, shared by every instance. A preset selected with
+        setCurrentProgram is heard from the next block; the parameters and user
+        curve follow on the message thread, which then sends a change message.
+    */
+    PresetBank& getPresetBank() noexcept     { return *presetBank; }
+
+    /** Message thread only. Saves the current settings as a user preset and selects it; returns its index, or -1. */
+    int saveUserPreset (const juce::String& name);
+    bool deleteUserPreset (int index);
+
+    /** Per-block levels and CPU load for the editor. Nothing is measured or queued
+        until the editor turns telemetry on, and the audio thread never waits on it.
+    */
+    void setTelemetryEnabled (bool shouldBeEnabled) noexcept    { telemetryEnabled = shouldBeEnabled; }
+    TelemetryQueue& getTelemetryQueue() noexcept                { return telemetryQueue; }
+
+    /** The output spectrum for the editor; only fed while a view has started it. */
+    SpectrumAnalyzer& getSpectrumAnalyzer() noexcept            { return spectrumAnalyzer; }
+
+    /** The current parameter values (or the preset standing in for them), as the DSP sees them. Safe from any thread. */
+    OverDriveSettings readSettings() const noexcept;
+
+    /** Blocks skipped because the input was silent and the effect had fully rung out. */
+    juce::uint64 getNumSkippedBlocks() const noexcept  { return core.getNumSkippedBlocks(); }
+
+    /** What this instance holds on its own, and what it shares with every other
+        instance in the process. Message thread only.
+    */
+    MemoryReport getMemoryReport() const;
+
 private:
-    juce::dsp::StateVariableTPTFilter<float> highPassFilter;
-    juce::dsp::StateVariableTPTFilter<float> lowPassFilter;
+    template <typename SampleType>
+    void processSamples (juce::AudioBuffer<SampleType>& buffer);
+
+    template <typename SampleType>
+    LevelReading measureLevel (const juce::AudioBuffer<SampleType>& buffer) const noexcept;
+
+    void handleAsyncUpdate() override;
+    void cancelOversamplingUpdate();
+
+    ParameterValues readParameterValues() const noexcept;
+    void applyValues (const ParameterValues& values, const UserCurve& curve);
+
+    // Parameter handles, cached at construction, by PresetParameters::Index
+    std::array<std::atomic<float>*, PresetParameters::numParameters> parameterValues {};
+
+    juce::SharedResourcePointer<PresetBank> presetBank;
+
+    // The selected preset, standing in for the parameters until the message thread has applied it
+    std::atomic<const PresetSnapshot*> presetOverride { nullptr };
+    std::atomic<int> currentProgram { 0 };
+
+    // Set once the audio thread has asked for an oversampling update, until the message thread has made it
+    std::atomic<bool> oversamplingUpdatePosted { false };
+
+    // All of the DSP; this class only connects it to the host, the parameters, presets and editor
+    OverDriveCore core;
+
+    std::atomic<bool> telemetryEnabled { false };
+    TelemetryQueue telemetryQueue;
+
+    SpectrumAnalyzer spectrumAnalyzer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OverDrive4AudioProcessor)
 };
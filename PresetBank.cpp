@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 17 Oct 2026 10:48:20pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+namespace
+{
+    ParameterValues getDefaultValues() noexcept
+    {
+        ParameterValues values;
+        std::copy (std::begin (PresetParameters::defaults), std::end (PresetParameters::defaults), values.begin());
+        return values;
+    }
+
+    // Factory presets, as changes from the defaults
+    struct FactoryPreset
+    {
+        const char* name;
+        std::initializer_list<std::pair<PresetParameters::Index, float>> changes;
+    };
+
+    using namespace PresetParameters;
+
+    const FactoryPreset factoryPresets[] =
+    {
+        { "Default",        {} },
+        { "Warm Tube",      { { curve, 1.0f }, { drive, 3.5f }, { mix, 70.0f }, { lowPassFreq, 9000.0f } } },
+        { "Bus Glue",       { { curve, 2.0f }, { drive, 1.5f }, { mix, 35.0f }, { gain, 0.5f } } },
+        { "Crunch",         { { drive, 7.0f }, { mix, 100.0f }, { gain, 0.0f }, { highPassFreq, 120.0f }, { lowPassFreq, 8000.0f },
+                              { oversampling, 1.0f } } },
+        { "Clean Drive",    { { drive, 2.5f }, { mix, 100.0f }, { antialiasing, 2.0f } } },
+        { "Fuzz",           { { curve, 3.0f }, { drive, 10.0f }, { mix, 100.0f }, { gain, 0.0f }, { highPassFreq, 200.0f },
+                              { lowPassFreq, 5000.0f }, { lowPassSlope, 1.0f }, { oversampling, 2.0f } } },
+        { "Foldback Synth", { { curve, 4.0f }, { drive, 4.0f }, { mix, 80.0f }, { gain, 0.0f }, { oversampling, 2.0f } } },
+        { "Telephone",      { { drive, 6.0f }, { mix, 100.0f }, { highPassFreq, 400.0f }, { lowPassFreq, 3200.0f },
+                              { highPassSlope, 3.0f }, { lowPassSlope, 3.0f } } },
+        { "Bass Bus",       { { bands, 1.0f }, { crossover1, 200.0f }, { mix, 100.0f }, { gain, 0.0f },
+                              { band1Drive, 1.5f }, { band1Mix, 60.0f }, { band2Drive, 6.0f }, { band2Gain, -2.0f } } },
+        { "Drum Bus",       { { bands, 2.0f }, { crossover1, 120.0f }, { crossover2, 4000.0f }, { mix, 100.0f }, { gain, 0.0f },
+                              { band1Drive, 2.0f }, { band1Mix, 50.0f }, { band2Drive, 5.0f }, { band3Drive, 3.0f }, { band3Mix, 60.0f } } },
+        { "Four Band Glue", { { bands, 3.0f }, { curve, 2.0f }, { mix, 100.0f }, { gain, 0.0f },
+                              { band1Drive, 2.0f }, { band1Mix, 40.0f }, { band2Drive, 3.0f }, { band2Mix, 60.0f },
+                              { band3Drive, 3.0f }, { band3Mix, 60.0f }, { band4Drive, 1.5f }, { band4Mix, 40.0f } } },
+        { "Pedal Drive",    { { driveModel, 1.0f }, { drive, 6.0f }, { tone, 40.0f }, { mix, 100.0f }, { gain, 0.0f },
+                              { oversampling, 1.0f } } },
+    };
+
+    // Sanity limits for counts read back from a block of data
+    constexpr int maximumStoredValues = 1024;
+}
+
+//==============================================================================
+std::unique_ptr<PresetSnapshot> PresetSnapshot::create (const juce::String& name, const ParameterValues& values,
+                                                        const UserCurve& userCurve, bool isFactory)
+{
+    auto snapshot = std::make_unique<PresetSnapshot>();
+    snapshot->name = name;
+    snapshot->values = values;
+    snapshot->userCurve = userCurve;
+    snapshot->userCurve.points[UserCurve::numPoints / 2] = 0.0f;
+    snapshot->settings = PresetParameters::toSettings (values);
+    snapshot->isFactory = isFactory;
+    return snapshot;
+}
+
+//==============================================================================
+void PresetFormat::write (juce::OutputStream& stream, const Contents& contents)
+{
+    stream.writeInt (magic);
+    stream.writeInt (currentVersion);
+    stream.writeInt (contents.program);
+    stream.writeString (contents.name);
+
+    stream.writeInt ((int) contents.values.size());
+
+    for (auto value : contents.values)
+        stream.writeFloat (value);
+
+    stream.writeInt (UserCurve::numPoints);
+
+    for (auto point : contents.userCurve.points)
+        stream.writeFloat (point);
+}
+
+namespace
+{
+    // Stored data may be damaged or hand-edited, so what is read back is put in range before it reaches the DSP settings
+    float sanitiseValue (int index, float value) noexcept
+    {
+        return std::isfinite (value) ? PresetParameters::constrain (index, value) : PresetParameters::defaults[index];
+    }
+
+    void sanitisePoint (float& point, float value) noexcept
+    {
+        if (std::isfinite (value))
+            point = juce::jlimit (-1.0f, 1.0f, value);
+    }
+
+    // The state before the binary format: the parameters' ValueTree, with the user curve as a property
+    bool readLegacyState (const void* data, size_t sizeInBytes, PresetFormat::Contents& contents)
+    {
+        const auto tree = juce::ValueTree::readFromData (data, sizeInBytes);
+
+        if (! tree.isValid())
+            return false;
+
+        for (int i = 0; i < PresetParameters::numParameters; ++i)
+        {
+            const auto child = tree.getChildWithProperty ("id", PresetParameters::ids[i]);
+
+            if (child.isValid() && child.hasProperty ("value"))
+                contents.values[(size_t) i] = sanitiseValue (i, (float) child.getProperty ("value"));
+        }
+
+        if (tree.hasProperty ("USER_CURVE"))
+            contents.userCurve = UserCurve::fromString (tree.getProperty ("USER_CURVE").toString());
+
+        return true;
+    }
+}
+
+bool PresetFormat::read (const void* data, size_t sizeInBytes, Contents& contents)
+{
+    contents = {};
+    contents.values = getDefaultValues();
+
+    if (data == nullptr || sizeInBytes < sizeof (juce::int32))
+        return false;
+
+    juce::MemoryInputStream stream (data, sizeInBytes, false);
+
+    if (stream.readInt() != magic)
+        return readLegacyState (data, sizeInBytes, contents);
+
+    // Every version so far shares this layout; a later one that doesn't would branch on this
+    const auto version = stream.readInt();
+
+    if (version < 1 || version > currentVersion)
+        return false;
+
+    contents.program = stream.readInt();
+    contents.name = stream.readString();
+
+    // Older versions stored fewer values; the ones they didn't have keep their defaults
+    const auto numValues = stream.readInt();
+
+    if (numValues < 0 || numValues > maximumStoredValues || stream.getNumBytesRemaining() < numValues * (juce::int64) sizeof (float))
+        return false;
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        const auto value = stream.readFloat();
+
+        if (i < PresetParameters::numParameters)
+            contents.values[(size_t) i] = sanitiseValue (i, value);
+    }
+
+    const auto numPoints = stream.readInt();
+
+    if (numPoints == UserCurve::numPoints && stream.getNumBytesRemaining() >= numPoints * (juce::int64) sizeof (float))
+        for (auto& point : contents.userCurve.points)
+            sanitisePoint (point, stream.readFloat());
+
+    return true;
+}
+
+//==============================================================================
+PresetBank::PresetBank()
+{
+    addFactoryPresets();
+    loadUserPresets();
+}
+
+int PresetBank::getNumPresets() const noexcept
+{
+    const juce::SpinLock::ScopedLockType sl (listLock);
+    return (int) presets.size();
+}
+
+const PresetSnapshot* PresetBank::getPreset (int index) const noexcept
+{
+    const juce::SpinLock::ScopedLockType sl (listLock);
+    return juce::isPositiveAndBelow (index, presets.size()) ? presets[(size_t) index] : nullptr;
+}
+
+size_t PresetBank::getMemoryUsage() const
+{
+    auto bytes = sizeof (*this) + storage.capacity() * sizeof (storage[0]);
+
+    for (const auto& snapshot : storage)
+        bytes += sizeof (PresetSnapshot) + (size_t) snapshot->name.getNumBytesAsUTF8();
+
+    const juce::SpinLock::ScopedLockType sl (listLock);
+    return bytes + presets.capacity() * sizeof (presets[0]);
+}
+
+void PresetBank::addFactoryPresets()
+{
+    std::vector<const PresetSnapshot*> newList;
+
+    for (const auto& preset : factoryPresets)
+    {
+        auto values = getDefaultValues();
+
+        for (const auto& change : preset.changes)
+            values[(size_t) change.first] = change.second;
+
+        storage.push_back (PresetSnapshot::create (preset.name, values, {}, true));
+        newList.push_back (storage.back().get());
+    }
+
+    publish (std::move (newList));
+}
+
+void PresetBank::loadUserPresets()
+{
+    auto files = getUserPresetFolder().findChildFiles (juce::File::findFiles, false, juce::String ("*") + fileExtension);
+    std::sort (files.begin(), files.end(), [] (const juce::File& a, const juce::File& b)
+    {
+        return a.getFileName().compareNatural (b.getFileName()) < 0;
+    });
+
+    std::vector<const PresetSnapshot*> newList;
+
+    {
+        const juce::SpinLock::ScopedLockType sl (listLock);
+        newList = presets;
+    }
+
+    for (const auto& file : files)
+    {
+        juce::MemoryBlock data;
+        PresetFormat::Contents contents;
+
+        if (! file.loadFileAsData (data) || ! PresetFormat::read (data.getData(), data.getSize(), contents))
+            continue;
+
+        const auto name = contents.name.isNotEmpty() ? contents.name : file.getFileNameWithoutExtension();
+        storage.push_back (PresetSnapshot::create (name, contents.values, contents.userCurve, false));
+        newList.push_back (storage.back().get());
+    }
+
+    publish (std::move (newList));
+}
+
+int PresetBank::saveUserPreset (const juce::String& name, const ParameterValues& values, const UserCurve& userCurve)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto snapshot = PresetSnapshot::create (name.trim(), values, userCurve, false);
+
+    PresetFormat::Contents contents;
+    contents.name = snapshot->name;
+    contents.values = snapshot->values;
+    contents.userCurve = snapshot->userCurve;
+
+    const auto file = getFileFor (contents.name);
+    file.getParentDirectory().createDirectory();
+
+    juce::MemoryOutputStream stream;
+    PresetFormat::write (stream, contents);
+
+    if (! file.replaceWithData (stream.getData(), stream.getDataSize()))
+        return -1;
+
+    return replaceOrAdd (std::move (snapshot));
+}
+
+bool PresetBank::renameUserPreset (int index, const juce::String& newName)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto* preset = getPreset (index);
+
+    if (preset == nullptr || preset->isFactory || newName.trim().isEmpty())
+        return false;
+
+    const auto sameFile = getFileFor (preset->name) == getFileFor (newName.trim());
+
+    if (saveUserPreset (newName, preset->values, preset->userCurve) < 0)
+        return false;
+
+    // Saved under the new name at the end of the list, so the old one is still at index
+    if (! sameFile)
+        removeUserPreset (index);
+
+    return true;
+}
+
+bool PresetBank::removeUserPreset (int index)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    std::vector<const PresetSnapshot*> newList;
+
+    {
+        const juce::SpinLock::ScopedLockType sl (listLock);
+        newList = presets;
+    }
+
+    if (! juce::isPositiveAndBelow (index, newList.size()) || newList[(size_t) index]->isFactory)
+        return false;
+
+    getFileFor (newList[(size_t) index]->name).deleteFile();
+
+    // The snapshot itself stays in storage, in case the audio thread is still using it
+    newList.erase (newList.begin() + index);
+    publish (std::move (newList));
+    return true;
+}
+
+int PresetBank::replaceOrAdd (std::unique_ptr<PresetSnapshot> snapshot)
+{
+    std::vector<const PresetSnapshot*> newList;
+
+    {
+        const juce::SpinLock::ScopedLockType sl (listLock);
+        newList = presets;
+    }
+
+    storage.push_back (std::move (snapshot));
+    const auto* added = storage.back().get();
+
+    auto existing = std::find_if (newList.begin(), newList.end(), [added] (const PresetSnapshot* preset)
+    {
+        return ! preset->isFactory && preset->name.equalsIgnoreCase (added->name);
+    });
+
+    if (existing == newList.end())
+        existing = newList.insert (newList.end(), added);
+    else
+        *existing = added;
+
+    const auto index = (int) std::distance (newList.begin(), existing);
+    publish (std::move (newList));
+    return index;
+}
+
+void PresetBank::publish (std::vector<const PresetSnapshot*> newList)
+{
+    // Only the swap happens under the lock; the old list is freed after it
+    const juce::SpinLock::ScopedLockType sl (listLock);
+    presets.swap (newList);
+}
+
+juce::File PresetBank::getUserPresetFolder()
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+               .getChildFile ("UnderratedFX").getChildFile ("OverDrive").getChildFile ("Presets");
+}
+
+juce::File PresetBank::getFileFor (const juce::String& name)
+{
+    return getUserPresetFolder().getChildFile (juce::File::createLegalFileName (name) + fileExtension);
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 17 Oct 2026 10:48:20pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PresetParameters.h"
+
+/*  Factory and user presets, and the format the plugin state is saved in.
+
+    A preset is a PresetSnapshot: the plain value of every parameter, the user
+    curve and the DSP settings they add up to. Snapshots are built on the
+    message thread and never change afterwards, so selecting one only hands
+    the audio thread a pointer to it. That pointer stands in for the
+    parameters until the message thread has caught the parameters up, which
+    makes switching presets during playback allocation- and lock-free.
+
+    The bank is shared by every instance in the process, so the factory
+    presets are built and the user preset folder scanned once, not once per
+    instance.
+*/
+struct PresetSnapshot
+{
+    juce::String name;
+    ParameterValues values;
+    UserCurve userCurve;
+    OverDriveSettings settings;     // What values add up to, ready for the audio thread
+    bool isFactory = false;
+
+    static std::unique_ptr<PresetSnapshot> create (const juce::String& name, const ParameterValues& values,
+                                                   const UserCurve& userCurve, bool isFactory);
+};
+
+//==============================================================================
+/** The binary state and preset file format.
+
+        int32   magic
+        int32   version
+        int32   selected program, or -1
+        string  preset name (UTF-8, may be empty)
+        int32   number of values, then that many float32 plain values in PresetParameters order
+        int32   number of user curve points, then that many float32 points
+
+    About 200 bytes, against a couple of kilobytes for the ValueTree the
+    state used to be. Values an older version didn't store keep their
+    defaults, and a block without the magic number is read as that old
+    ValueTree state.
+*/
+namespace PresetFormat
+{
+    constexpr juce::int32 magic = 0x31534f44;   // "DOS1"
+    constexpr int currentVersion = 1;
+
+    struct Contents
+    {
+        juce::String name;
+        ParameterValues values;
+        UserCurve userCurve;
+        int program = -1;
+    };
+
+    void write (juce::OutputStream& stream, const Contents& contents);
+
+    /** Reads any version of the format, or the old ValueTree state. Returns false if the data is neither.
+        Values come back clamped to their parameters' ranges, with anything not finite left at its default.
+    */
+    bool read (const void* data, size_t sizeInBytes, Contents& contents);
+}
+
+//==============================================================================
+class PresetBank
+{
+public:
+    /** Builds the factory presets and loads the user presets from disk. */
+    PresetBank();
+
+    /** Safe from any thread. */
+    int getNumPresets() const noexcept;
+
+    /** Safe from any thread; null if index is out of range. Snapshots live as
+        long as the bank, even after the preset is removed, so a pointer handed
+        to the audio thread never dangles.
+    */
+    const PresetSnapshot* getPreset (int index) const noexcept;
+
+    /** Message thread only. Saves a user preset to disk, replacing any of the
+        same name, and returns its index.
+    */
+    int saveUserPreset (const juce::String& name, const ParameterValues& values, const UserCurve& userCurve);
+
+    /** Message thread only. Factory presets can't be renamed or removed. */
+    bool renameUserPreset (int index, const juce::String& newName);
+    bool removeUserPreset (int index);
+
+    /** Message thread only. Bytes held by the presets, including removed ones that are kept alive. */
+    size_t getMemoryUsage() const;
+
+    static juce::File getUserPresetFolder();
+    static constexpr const char* fileExtension = ".odpreset";
+
+private:
+    void addFactoryPresets();
+    void loadUserPresets();
+    int replaceOrAdd (std::unique_ptr<PresetSnapshot> snapshot);
+    void publish (std::vector<const PresetSnapshot*> newList);
+    static juce::File getFileFor (const juce::String& name);
+
+    // Everything ever created, so published pointers stay valid. Message thread only.
+    std::vector<std::unique_ptr<PresetSnapshot>> storage;
+
+    // The current list. Rebuilt off to the side and swapped in under the lock, so it is only held for a swap or a read.
+    mutable juce::SpinLock listLock;
+    std::vector<const PresetSnapshot*> presets;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBank)
+};
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    PresetBar.cpp
+    Created: 17 Oct 2026 11:02:37pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "PresetBar.h"
+
+PresetBar::PresetBar (OverDrive4AudioProcessor& p)
+    : processor (p)
+{
+    presetBox.setTextWhenNothingSelected ("Presets");
+    presetBox.onChange = [this]
+    {
+        const auto index = presetBox.getSelectedId() - 1;
+
+        if (index >= 0 && index != processor.getCurrentProgram())
+            processor.setCurrentProgram (index);
+
+        refresh();
+    };
+    addAndMakeVisible (presetBox);
+
+    saveButton.onClick = [this] { showSaveDialog(); };
+    addAndMakeVisible (saveButton);
+
+    deleteButton.onClick = [this]
+    {
+        processor.deleteUserPreset (processor.getCurrentProgram());
+        refresh();
+    };
+    addAndMakeVisible (deleteButton);
+
+    processor.addChangeListener (this);
+    refresh();
+}
+
+PresetBar::~PresetBar()
+{
+    processor.removeChangeListener (this);
+}
+
+void PresetBar::resized()
+{
+    auto bounds = getLocalBounds();
+    deleteButton.setBounds (bounds.removeFromRight (48));
+    bounds.removeFromRight (4);
+    saveButton.setBounds (bounds.removeFromRight (40));
+    bounds.removeFromRight (4);
+    presetBox.setBounds (bounds);
+}
+
+void PresetBar::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    refresh();
+}
+
+void PresetBar::refresh()
+{
+    // Item IDs are program index + 1; factory presets first, then the user's
+    auto& bank = processor.getPresetBank();
+    presetBox.clear (juce::dontSendNotification);
+
+    bool inUserSection = false;
+
+    for (int i = 0; i < bank.getNumPresets(); ++i)
+    {
+        const auto* preset = bank.getPreset (i);
+
+        if (preset == nullptr)
+            continue;
+
+        if (! preset->isFactory && ! inUserSection)
+        {
+            presetBox.addSeparator();
+            inUserSection = true;
+        }
+
+        presetBox.addItem (preset->name, i + 1);
+    }
+
+    const auto* current = bank.getPreset (processor.getCurrentProgram());
+    presetBox.setSelectedId (processor.getCurrentProgram() + 1, juce::dontSendNotification);
+    deleteButton.setEnabled (current != nullptr && ! current->isFactory);
+}
+
+void PresetBar::showSaveDialog()
+{
+    auto* window = new juce::AlertWindow ("Save Preset", "Name the preset. A user preset of the same name is replaced.",
+                                          juce::MessageBoxIconType::NoIcon, this);
+    window->addTextEditor ("name", presetBox.getText());
+    window->addButton ("Save", 1, juce::KeyPress (juce::KeyPress::returnKey));
+    window->addButton ("Cancel", 0, juce::KeyPress (juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<PresetBar> safeThis (this);
+
+    window->enterModalState (true, juce::ModalCallbackFunction::create ([safeThis, window] (int result)
+    {
+        const auto name = window->getTextEditorContents ("name").trim();
+
+        if (safeThis == nullptr || result == 0 || name.isEmpty())
+            return;
+
+        if (safeThis->processor.saveUserPreset (name) < 0)
+            juce::AlertWindow::showMessageBoxAsync (juce::MessageBoxIconType::WarningIcon, "Save Preset",
+                                                    "The preset couldn't be written to " + PresetBank::getUserPresetFolder().getFullPathName());
+
+        safeThis->refresh();
+    }), true);
+}
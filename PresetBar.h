@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    PresetBar.h
+    Created: 17 Oct 2026 11:02:37pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+/** Preset selector with Save and Delete buttons. Selecting a preset goes
+    through setCurrentProgram, the same as a host program change. Only user
+    presets can be deleted.
+*/
+class PresetBar : public juce::Component,
+                  private juce::ChangeListener
+{
+public:
+    explicit PresetBar (OverDrive4AudioProcessor&);
+    ~PresetBar() override;
+
+    void resized() override;
+
+private:
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+    void refresh();
+    void showSaveDialog();
+
+    OverDrive4AudioProcessor& processor;
+
+    juce::ComboBox presetBox;
+    juce::TextButton saveButton { "Save" };
+    juce::TextButton deleteButton { "Delete" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBar)
+};
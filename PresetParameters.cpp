@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    PresetParameters.cpp
+    Created: 18 Oct 2026 3:14:52am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "PresetParameters.h"
+
+const char* const PresetParameters::ids[numParameters] =
+{
+    "DRIVE", "GAIN", "MIX", "HPF_FREQ", "LPF_FREQ", "SAT_ACCURACY", "OVERSAMPLING", "OS_FILTER",
+    "FILTER_UPDATE", "ANTIALIASING", "CURVE", "HPF_SLOPE", "LPF_SLOPE", "FILTER_TYPE",
+    "BANDS", "XOVER_1", "XOVER_2", "XOVER_3",
+    "BAND1_DRIVE", "BAND1_GAIN", "BAND1_MIX", "BAND2_DRIVE", "BAND2_GAIN", "BAND2_MIX",
+    "BAND3_DRIVE", "BAND3_GAIN", "BAND3_MIX", "BAND4_DRIVE", "BAND4_GAIN", "BAND4_MIX",
+    "QUALITY", "BOUNCE_QUALITY",
+    "DRIVE_MODEL", "TONE"
+};
+
+const float PresetParameters::defaults[numParameters] =
+{
+    5.0f, 1.0f, 50.0f, 20.0f, 20000.0f, 2.0f, 0.0f, 0.0f,
+    1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 150.0f, 1000.0f, 5000.0f,
+    5.0f, 0.0f, 100.0f, 5.0f, 0.0f, 100.0f,
+    5.0f, 0.0f, 100.0f, 5.0f, 0.0f, 100.0f,
+    0.0f, 1.0f,
+    0.0f, 50.0f
+};
+
+const PresetParameters::Range PresetParameters::ranges[numParameters] =
+{
+    { 0.0f, 10.0f, false }, { 0.0f, 10.0f, false }, { 0.0f, 100.0f, false }, { 20.0f, 20000.0f, false }, { 20.0f, 20000.0f, false },
+    { 0.0f, 2.0f, true }, { 0.0f, 3.0f, true }, { 0.0f, 1.0f, true },
+    { 0.0f, 2.0f, true }, { 0.0f, 2.0f, true }, { 0.0f, 5.0f, true }, { 0.0f, 3.0f, true }, { 0.0f, 3.0f, true }, { 0.0f, 1.0f, true },
+    { 0.0f, 3.0f, true }, { 20.0f, 20000.0f, false }, { 20.0f, 20000.0f, false }, { 20.0f, 20000.0f, false },
+    { 0.0f, 10.0f, false }, { -12.0f, 12.0f, false }, { 0.0f, 100.0f, false }, { 0.0f, 10.0f, false }, { -12.0f, 12.0f, false }, { 0.0f, 100.0f, false },
+    { 0.0f, 10.0f, false }, { -12.0f, 12.0f, false }, { 0.0f, 100.0f, false }, { 0.0f, 10.0f, false }, { -12.0f, 12.0f, false }, { 0.0f, 100.0f, false },
+    { 0.0f, 3.0f, true }, { 0.0f, 1.0f, true },
+    { 0.0f, 1.0f, true }, { 0.0f, 100.0f, false }
+};
+
+namespace
+{
+    constexpr int filterUpdateIntervals[] = { 8, 16, 32 };
+}
+
+int PresetParameters::indexOf (const juce::String& parameterID) noexcept
+{
+    for (int i = 0; i < numParameters; ++i)
+        if (parameterID == ids[i])
+            return i;
+
+    return -1;
+}
+
+float PresetParameters::constrain (int index, float value) noexcept
+{
+    jassert (juce::isPositiveAndBelow (index, (int) numParameters));
+
+    const auto& range = ranges[index];
+    value = juce::jlimit (range.minimum, range.maximum, value);
+    return range.isChoice ? (float) juce::roundToInt (value) : value;
+}
+
+//==============================================================================
+OverDriveSettings PresetParameters::toSettings (const ParameterValues& values) noexcept
+{
+    OverDriveSettings settings;
+    settings.drive = values[drive];
+    settings.gainDecibels = values[gain];
+    settings.mixPercent = values[mix];
+    settings.highPassHz = values[highPassFreq];
+    settings.lowPassHz = values[lowPassFreq];
+    settings.highPassSections = juce::jlimit (1, maxTPTSections, (int) values[highPassSlope] + 1);
+    settings.lowPassSections = juce::jlimit (1, maxTPTSections, (int) values[lowPassSlope] + 1);
+    settings.filterAlignment = values[filterType] > 0.5f ? FilterAlignment::linkwitzRiley : FilterAlignment::butterworth;
+    settings.curve = (WaveshaperCurve) juce::jlimit (0, (int) WaveshaperCurve::user, (int) values[curve]);
+    settings.accuracy = (SaturationKernel::Accuracy) juce::jlimit (0, (int) SaturationKernel::Accuracy::accurate, (int) values[saturationAccuracy]);
+    settings.filterUpdateInterval = filterUpdateIntervals[juce::jlimit (0, 2, (int) values[filterUpdate])];
+    settings.oversamplingIndex = juce::jlimit (0, 3, (int) values[oversampling]);
+    settings.linearPhaseOversampling = values[oversamplingFilter] > 0.5f;
+    settings.antialiasingOrder = juce::jlimit (0, 2, (int) values[antialiasing]);
+    settings.quality = (QualityTier) juce::jlimit (0, (int) QualityTier::render, (int) values[quality]);
+    settings.renderTierOffline = values[bounceQuality] > 0.5f;
+    settings.driveModel = values[driveModel] > 0.5f ? DriveModel::diodeClipper : DriveModel::waveshaper;
+    settings.tonePercent = values[tone];
+
+    auto& multiband = settings.multiband;
+    multiband.numBands = juce::jlimit (1, maxBands, (int) values[bands] + 1);
+
+    for (size_t i = 0; i < multiband.crossoverHz.size(); ++i)
+        multiband.crossoverHz[i] = values[crossover1 + i];
+
+    for (size_t band = 0; band < (size_t) maxBands; ++band)
+    {
+        multiband.drive[band] = values[band1Drive + 3 * band];
+        multiband.gainDecibels[band] = values[band1Gain + 3 * band];
+        multiband.mixPercent[band] = values[band1Mix + 3 * band];
+    }
+
+    applyQualityTier (settings, settings.quality);
+    return settings;
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    PresetParameters.h
+    Created: 18 Oct 2026 3:14:52am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "OverDriveDSP.h"
+
+/*  The effect's parameters as plain values, and the DSP settings they add up
+    to. This is the part of the preset code OverDriveCore needs, so it builds
+    into the core library on its own; the factory and user presets and the
+    saved state format (PresetBank.h) stay with the plugin.
+*/
+namespace PresetParameters
+{
+    /** Every parameter, in the order the binary format stores them. New
+        parameters only ever go on the end, so older data still lines up.
+    */
+    enum Index
+    {
+        drive,
+        gain,
+        mix,
+        highPassFreq,
+        lowPassFreq,
+        saturationAccuracy,
+        oversampling,
+        oversamplingFilter,
+        filterUpdate,
+        antialiasing,
+        curve,
+        highPassSlope,
+        lowPassSlope,
+        filterType,
+        bands,
+        crossover1,
+        crossover2,
+        crossover3,
+        band1Drive, band1Gain, band1Mix,     // Drive, gain and mix for each band, in that order
+        band2Drive, band2Gain, band2Mix,
+        band3Drive, band3Gain, band3Mix,
+        band4Drive, band4Gain, band4Mix,
+        quality, bounceQuality,              // New parameters go last, so states saved before them load their defaults
+        driveModel, tone,
+        numParameters
+    };
+
+    /** Parameter IDs and default plain values, by Index. The defaults must match the parameter layout. */
+    extern const char* const ids[numParameters];
+    extern const float defaults[numParameters];
+
+    /** Plain value ranges, by Index, also matching the layout. A choice runs
+        from 0 to one less than its number of options.
+    */
+    struct Range
+    {
+        float minimum, maximum;
+        bool isChoice;
+    };
+
+    extern const Range ranges[numParameters];
+
+    /** The Index of a parameter ID, or -1. */
+    int indexOf (const juce::String& parameterID) noexcept;
+
+    /** Clamps a plain value into its parameter's range, rounding a choice to the nearest option. */
+    float constrain (int index, float value) noexcept;
+}
+
+using ParameterValues = std::array<float, PresetParameters::numParameters>;
+
+namespace PresetParameters
+{
+    /** Plain parameter values to the settings the DSP runs on. */
+    OverDriveSettings toSettings (const ParameterValues& values) noexcept;
+}
@@ -0,0 +1,465 @@
+/*
+  ==============================================================================
+
+    SaturationKernel.cpp
+    Created: 17 Oct 2026 10:02:51am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include "SaturationKernel.h"
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #define OVERDRIVE_SATURATION_X86 1
+ #include <immintrin.h>
+#elif defined (__aarch64__) || defined (_M_ARM64)
+ #define OVERDRIVE_SATURATION_NEON 1
+ #include <arm_neon.h>
+#endif
+
+// GCC and Clang need each wider kernel tagged with its target; MSVC emits any intrinsic as written.
+#if OVERDRIVE_SATURATION_X86 && (defined (__GNUC__) || defined (__clang__))
+ #define OVERDRIVE_TARGET_SSE2    __attribute__ ((target ("sse2")))
+ #define OVERDRIVE_TARGET_AVX2    __attribute__ ((target ("avx2,fma")))
+ #define OVERDRIVE_TARGET_AVX512  __attribute__ ((target ("avx512f")))
+#else
+ #define OVERDRIVE_TARGET_SSE2
+ #define OVERDRIVE_TARGET_AVX2
+ #define OVERDRIVE_TARGET_AVX512
+#endif
+
+namespace
+{
+    // Coefficients of x * P(x^2) / Q(x^2), highest power first for Horner evaluation
+    struct FastTier
+    {
+        static constexpr float limit = 3.0f;
+        static constexpr float numerator[]   = { 1.0f, 27.0f };
+        static constexpr float denominator[] = { 9.0f, 27.0f };
+    };
+
+    struct BalancedTier
+    {
+        static constexpr float limit = 5.0f;
+        static constexpr float numerator[]   = { 1.0f, 378.0f, 17325.0f, 135135.0f };
+        static constexpr float denominator[] = { 28.0f, 3150.0f, 62370.0f, 135135.0f };
+    };
+
+    struct AccurateTier
+    {
+        static constexpr float limit = 7.90531110763549805f;
+        static constexpr float numerator[]   = { -2.76076847742355e-16f, 2.00018790482477e-13f, -8.60467152213735e-11f,
+                                                  5.12229709037114e-08f, 1.48572235717979e-05f, 6.37261928875436e-04f,
+                                                  4.89352455891786e-03f };
+        static constexpr float denominator[] = { 1.19825839466702e-06f, 1.18534705686654e-04f, 2.26843463243900e-03f,
+                                                  4.89352518554385e-03f };
+    };
+
+    //==============================================================================
+    // Both precisions use the same float coefficients. In double the curve is
+    // no more accurate, but the samples around it keep their full precision.
+    template <typename Tier, typename SampleType>
+    inline SampleType saturateSample (SampleType x) noexcept
+    {
+        x = juce::jlimit ((SampleType) -Tier::limit, (SampleType) Tier::limit, x);
+        const auto x2 = x * x;
+
+        auto num = (SampleType) Tier::numerator[0];
+        for (size_t i = 1; i < std::size (Tier::numerator); ++i)
+            num = num * x2 + (SampleType) Tier::numerator[i];
+
+        auto den = (SampleType) Tier::denominator[0];
+        for (size_t i = 1; i < std::size (Tier::denominator); ++i)
+            den = den * x2 + (SampleType) Tier::denominator[i];
+
+        return juce::jlimit ((SampleType) -1, (SampleType) 1, x * num / den);
+    }
+
+    template <typename Tier, typename SampleType>
+    void processScalar (const SampleType* input, SampleType* output, int numSamples, SampleType drive, SampleType gain) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = saturateSample<Tier> (drive * input[i]) * gain;
+    }
+
+   #if OVERDRIVE_SATURATION_X86
+    //==============================================================================
+    // One set of vector operations per instruction set and precision, so each
+    // kernel below is written once for float and double
+    template <typename SampleType> struct SSE2;
+
+    template <> struct SSE2<float>
+    {
+        using Vector = __m128;
+        static constexpr int width = 4;
+
+        OVERDRIVE_TARGET_SSE2 static Vector load (const float* p) noexcept             { return _mm_loadu_ps (p); }
+        OVERDRIVE_TARGET_SSE2 static void store (float* p, Vector v) noexcept          { _mm_storeu_ps (p, v); }
+        OVERDRIVE_TARGET_SSE2 static Vector expand (float x) noexcept                  { return _mm_set1_ps (x); }
+        OVERDRIVE_TARGET_SSE2 static Vector mul (Vector a, Vector b) noexcept          { return _mm_mul_ps (a, b); }
+        OVERDRIVE_TARGET_SSE2 static Vector div (Vector a, Vector b) noexcept          { return _mm_div_ps (a, b); }
+        OVERDRIVE_TARGET_SSE2 static Vector mulAdd (Vector a, Vector b, Vector c) noexcept { return _mm_add_ps (_mm_mul_ps (a, b), c); }
+        OVERDRIVE_TARGET_SSE2 static Vector clamp (Vector v, Vector lo, Vector hi) noexcept { return _mm_min_ps (_mm_max_ps (v, lo), hi); }
+    };
+
+    template <> struct SSE2<double>
+    {
+        using Vector = __m128d;
+        static constexpr int width = 2;
+
+        OVERDRIVE_TARGET_SSE2 static Vector load (const double* p) noexcept            { return _mm_loadu_pd (p); }
+        OVERDRIVE_TARGET_SSE2 static void store (double* p, Vector v) noexcept         { _mm_storeu_pd (p, v); }
+        OVERDRIVE_TARGET_SSE2 static Vector expand (double x) noexcept                 { return _mm_set1_pd (x); }
+        OVERDRIVE_TARGET_SSE2 static Vector mul (Vector a, Vector b) noexcept          { return _mm_mul_pd (a, b); }
+        OVERDRIVE_TARGET_SSE2 static Vector div (Vector a, Vector b) noexcept          { return _mm_div_pd (a, b); }
+        OVERDRIVE_TARGET_SSE2 static Vector mulAdd (Vector a, Vector b, Vector c) noexcept { return _mm_add_pd (_mm_mul_pd (a, b), c); }
+        OVERDRIVE_TARGET_SSE2 static Vector clamp (Vector v, Vector lo, Vector hi) noexcept { return _mm_min_pd (_mm_max_pd (v, lo), hi); }
+    };
+
+    template <typename SampleType> struct AVX2;
+
+    template <> struct AVX2<float>
+    {
+        using Vector = __m256;
+        static constexpr int width = 8;
+
+        OVERDRIVE_TARGET_AVX2 static Vector load (const float* p) noexcept             { return _mm256_loadu_ps (p); }
+        OVERDRIVE_TARGET_AVX2 static void store (float* p, Vector v) noexcept          { _mm256_storeu_ps (p, v); }
+        OVERDRIVE_TARGET_AVX2 static Vector expand (float x) noexcept                  { return _mm256_set1_ps (x); }
+        OVERDRIVE_TARGET_AVX2 static Vector mul (Vector a, Vector b) noexcept          { return _mm256_mul_ps (a, b); }
+        OVERDRIVE_TARGET_AVX2 static Vector div (Vector a, Vector b) noexcept          { return _mm256_div_ps (a, b); }
+        OVERDRIVE_TARGET_AVX2 static Vector mulAdd (Vector a, Vector b, Vector c) noexcept { return _mm256_fmadd_ps (a, b, c); }
+        OVERDRIVE_TARGET_AVX2 static Vector clamp (Vector v, Vector lo, Vector hi) noexcept { return _mm256_min_ps (_mm256_max_ps (v, lo), hi); }
+    };
+
+    template <> struct AVX2<double>
+    {
+        using Vector = __m256d;
+        static constexpr int width = 4;
+
+        OVERDRIVE_TARGET_AVX2 static Vector load (const double* p) noexcept            { return _mm256_loadu_pd (p); }
+        OVERDRIVE_TARGET_AVX2 static void store (double* p, Vector v) noexcept         { _mm256_storeu_pd (p, v); }
+        OVERDRIVE_TARGET_AVX2 static Vector expand (double x) noexcept                 { return _mm256_set1_pd (x); }
+        OVERDRIVE_TARGET_AVX2 static Vector mul (Vector a, Vector b) noexcept          { return _mm256_mul_pd (a, b); }
+        OVERDRIVE_TARGET_AVX2 static Vector div (Vector a, Vector b) noexcept          { return _mm256_div_pd (a, b); }
+        OVERDRIVE_TARGET_AVX2 static Vector mulAdd (Vector a, Vector b, Vector c) noexcept { return _mm256_fmadd_pd (a, b, c); }
+        OVERDRIVE_TARGET_AVX2 static Vector clamp (Vector v, Vector lo, Vector hi) noexcept { return _mm256_min_pd (_mm256_max_pd (v, lo), hi); }
+    };
+
+    template <typename SampleType> struct AVX512;
+
+    template <> struct AVX512<float>
+    {
+        using Vector = __m512;
+        static constexpr int width = 16;
+
+        OVERDRIVE_TARGET_AVX512 static Vector load (const float* p) noexcept           { return _mm512_loadu_ps (p); }
+        OVERDRIVE_TARGET_AVX512 static void store (float* p, Vector v) noexcept        { _mm512_storeu_ps (p, v); }
+        OVERDRIVE_TARGET_AVX512 static Vector expand (float x) noexcept                { return _mm512_set1_ps (x); }
+        OVERDRIVE_TARGET_AVX512 static Vector mul (Vector a, Vector b) noexcept        { return _mm512_mul_ps (a, b); }
+        OVERDRIVE_TARGET_AVX512 static Vector div (Vector a, Vector b) noexcept        { return _mm512_div_ps (a, b); }
+        OVERDRIVE_TARGET_AVX512 static Vector mulAdd (Vector a, Vector b, Vector c) noexcept { return _mm512_fmadd_ps (a, b, c); }
+        OVERDRIVE_TARGET_AVX512 static Vector clamp (Vector v, Vector lo, Vector hi) noexcept { return _mm512_min_ps (_mm512_max_ps (v, lo), hi); }
+    };
+
+    template <> struct AVX512<double>
+    {
+        using Vector = __m512d;
+        static constexpr int width = 8;
+
+        OVERDRIVE_TARGET_AVX512 static Vector load (const double* p) noexcept          { return _mm512_loadu_pd (p); }
+        OVERDRIVE_TARGET_AVX512 static void store (double* p, Vector v) noexcept       { _mm512_storeu_pd (p, v); }
+        OVERDRIVE_TARGET_AVX512 static Vector expand (double x) noexcept               { return _mm512_set1_pd (x); }
+        OVERDRIVE_TARGET_AVX512 static Vector mul (Vector a, Vector b) noexcept        { return _mm512_mul_pd (a, b); }
+        OVERDRIVE_TARGET_AVX512 static Vector div (Vector a, Vector b) noexcept        { return _mm512_div_pd (a, b); }
+        OVERDRIVE_TARGET_AVX512 static Vector mulAdd (Vector a, Vector b, Vector c) noexcept { return _mm512_fmadd_pd (a, b, c); }
+        OVERDRIVE_TARGET_AVX512 static Vector clamp (Vector v, Vector lo, Vector hi) noexcept { return _mm512_min_pd (_mm512_max_pd (v, lo), hi); }
+    };
+
+    //==============================================================================
+    template <typename Tier, typename SampleType>
+    OVERDRIVE_TARGET_SSE2 void processSSE2 (const SampleType* input, SampleType* output, int numSamples, SampleType drive, SampleType gain) noexcept
+    {
+        using V = SSE2<SampleType>;
+
+        const auto vDrive = V::expand (drive);
+        const auto vGain  = V::expand (gain);
+        const auto vLimit = V::expand ((SampleType) Tier::limit), vMinusLimit = V::expand ((SampleType) -Tier::limit);
+        const auto vOne   = V::expand ((SampleType) 1), vMinusOne = V::expand ((SampleType) -1);
+
+        int i = 0;
+
+        for (; i + V::width <= numSamples; i += V::width)
+        {
+            const auto x = V::clamp (V::mul (V::load (input + i), vDrive), vMinusLimit, vLimit);
+            const auto x2 = V::mul (x, x);
+
+            auto num = V::expand ((SampleType) Tier::numerator[0]);
+            for (size_t c = 1; c < std::size (Tier::numerator); ++c)
+                num = V::mulAdd (num, x2, V::expand ((SampleType) Tier::numerator[c]));
+
+            auto den = V::expand ((SampleType) Tier::denominator[0]);
+            for (size_t c = 1; c < std::size (Tier::denominator); ++c)
+                den = V::mulAdd (den, x2, V::expand ((SampleType) Tier::denominator[c]));
+
+            const auto y = V::clamp (V::div (V::mul (x, num), den), vMinusOne, vOne);
+            V::store (output + i, V::mul (y, vGain));
+        }
+
+        processScalar<Tier> (input + i, output + i, numSamples - i, drive, gain);
+    }
+
+    template <typename Tier, typename SampleType>
+    OVERDRIVE_TARGET_AVX2 void processAVX2 (const SampleType* input, SampleType* output, int numSamples, SampleType drive, SampleType gain) noexcept
+    {
+        using V = AVX2<SampleType>;
+
+        const auto vDrive = V::expand (drive);
+        const auto vGain  = V::expand (gain);
+        const auto vLimit = V::expand ((SampleType) Tier::limit), vMinusLimit = V::expand ((SampleType) -Tier::limit);
+        const auto vOne   = V::expand ((SampleType) 1), vMinusOne = V::expand ((SampleType) -1);
+
+        int i = 0;
+
+        for (; i + V::width <= numSamples; i += V::width)
+        {
+            const auto x = V::clamp (V::mul (V::load (input + i), vDrive), vMinusLimit, vLimit);
+            const auto x2 = V::mul (x, x);
+
+            auto num = V::expand ((SampleType) Tier::numerator[0]);
+            for (size_t c = 1; c < std::size (Tier::numerator); ++c)
+                num = V::mulAdd (num, x2, V::expand ((SampleType) Tier::numerator[c]));
+
+            auto den = V::expand ((SampleType) Tier::denominator[0]);
+            for (size_t c = 1; c < std::size (Tier::denominator); ++c)
+                den = V::mulAdd (den, x2, V::expand ((SampleType) Tier::denominator[c]));
+
+            const auto y = V::clamp (V::div (V::mul (x, num), den), vMinusOne, vOne);
+            V::store (output + i, V::mul (y, vGain));
+        }
+
+        processScalar<Tier> (input + i, output + i, numSamples - i, drive, gain);
+    }
+
+    template <typename Tier, typename SampleType>
+    OVERDRIVE_TARGET_AVX512 void processAVX512 (const SampleType* input, SampleType* output, int numSamples, SampleType drive, SampleType gain) noexcept
+    {
+        using V = AVX512<SampleType>;
+
+        const auto vDrive = V::expand (drive);
+        const auto vGain  = V::expand (gain);
+        const auto vLimit = V::expand ((SampleType) Tier::limit), vMinusLimit = V::expand ((SampleType) -Tier::limit);
+        const auto vOne   = V::expand ((SampleType) 1), vMinusOne = V::expand ((SampleType) -1);
+
+        int i = 0;
+
+        for (; i + V::width <= numSamples; i += V::width)
+        {
+            const auto x = V::clamp (V::mul (V::load (input + i), vDrive), vMinusLimit, vLimit);
+            const auto x2 = V::mul (x, x);
+
+            auto num = V::expand ((SampleType) Tier::numerator[0]);
+            for (size_t c = 1; c < std::size (Tier::numerator); ++c)
+                num = V::mulAdd (num, x2, V::expand ((SampleType) Tier::numerator[c]));
+
+            auto den = V::expand ((SampleType) Tier::denominator[0]);
+            for (size_t c = 1; c < std::size (Tier::denominator); ++c)
+                den = V::mulAdd (den, x2, V::expand ((SampleType) Tier::denominator[c]));
+
+            const auto y = V::clamp (V::div (V::mul (x, num), den), vMinusOne, vOne);
+            V::store (output + i, V::mul (y, vGain));
+        }
+
+        processScalar<Tier> (input + i, output + i, numSamples - i, drive, gain);
+    }
+   #endif
+
+   #if OVERDRIVE_SATURATION_NEON
+    //==============================================================================
+    template <typename SampleType> struct Neon;
+
+    template <> struct Neon<float>
+    {
+        using Vector = float32x4_t;
+        static constexpr int width = 4;
+
+        static Vector load (const float* p) noexcept                     { return vld1q_f32 (p); }
+        static void store (float* p, Vector v) noexcept                  { vst1q_f32 (p, v); }
+        static Vector expand (float x) noexcept                          { return vdupq_n_f32 (x); }
+        static Vector mul (Vector a, Vector b) noexcept                  { return vmulq_f32 (a, b); }
+        static Vector div (Vector a, Vector b) noexcept                  { return vdivq_f32 (a, b); }
+        static Vector mulAdd (Vector a, Vector b, Vector c) noexcept     { return vfmaq_f32 (c, a, b); }
+        static Vector clamp (Vector v, Vector lo, Vector hi) noexcept    { return vminq_f32 (vmaxq_f32 (v, lo), hi); }
+    };
+
+    template <> struct Neon<double>
+    {
+        using Vector = float64x2_t;
+        static constexpr int width = 2;
+
+        static Vector load (const double* p) noexcept                    { return vld1q_f64 (p); }
+        static void store (double* p, Vector v) noexcept                 { vst1q_f64 (p, v); }
+        static Vector expand (double x) noexcept                         { return vdupq_n_f64 (x); }
+        static Vector mul (Vector a, Vector b) noexcept                  { return vmulq_f64 (a, b); }
+        static Vector div (Vector a, Vector b) noexcept                  { return vdivq_f64 (a, b); }
+        static Vector mulAdd (Vector a, Vector b, Vector c) noexcept     { return vfmaq_f64 (c, a, b); }
+        static Vector clamp (Vector v, Vector lo, Vector hi) noexcept    { return vminq_f64 (vmaxq_f64 (v, lo), hi); }
+    };
+
+    template <typename Tier, typename SampleType>
+    void processNeon (const SampleType* input, SampleType* output, int numSamples, SampleType drive, SampleType gain) noexcept
+    {
+        using V = Neon<SampleType>;
+
+        const auto vDrive = V::expand (drive);
+        const auto vGain  = V::expand (gain);
+        const auto vLimit = V::expand ((SampleType) Tier::limit), vMinusLimit = V::expand ((SampleType) -Tier::limit);
+        const auto vOne   = V::expand ((SampleType) 1), vMinusOne = V::expand ((SampleType) -1);
+
+        int i = 0;
+
+        for (; i + V::width <= numSamples; i += V::width)
+        {
+            const auto x = V::clamp (V::mul (V::load (input + i), vDrive), vMinusLimit, vLimit);
+            const auto x2 = V::mul (x, x);
+
+            auto num = V::expand ((SampleType) Tier::numerator[0]);
+            for (size_t c = 1; c < std::size (Tier::numerator); ++c)
+                num = V::mulAdd (num, x2, V::expand ((SampleType) Tier::numerator[c]));
+
+            auto den = V::expand ((SampleType) Tier::denominator[0]);
+            for (size_t c = 1; c < std::size (Tier::denominator); ++c)
+                den = V::mulAdd (den, x2, V::expand ((SampleType) Tier::denominator[c]));
+
+            const auto y = V::clamp (V::div (V::mul (x, num), den), vMinusOne, vOne);
+            V::store (output + i, V::mul (y, vGain));
+        }
+
+        processScalar<Tier> (input + i, output + i, numSamples - i, drive, gain);
+    }
+   #endif
+
+    //==============================================================================
+    template <typename SampleType>
+    using KernelFunction = void (*) (const SampleType*, SampleType*, int, SampleType, SampleType) noexcept;
+
+    template <typename Tier, typename SampleType>
+    KernelFunction<SampleType> selectKernel (SaturationKernel::InstructionSet set) noexcept
+    {
+        switch (set)
+        {
+           #if OVERDRIVE_SATURATION_X86
+            case SaturationKernel::InstructionSet::sse2:    return processSSE2<Tier, SampleType>;
+            case SaturationKernel::InstructionSet::avx2:    return processAVX2<Tier, SampleType>;
+            case SaturationKernel::InstructionSet::avx512:  return processAVX512<Tier, SampleType>;
+           #endif
+           #if OVERDRIVE_SATURATION_NEON
+            case SaturationKernel::InstructionSet::neon:    return processNeon<Tier, SampleType>;
+           #endif
+            default:                                        return processScalar<Tier, SampleType>;
+        }
+    }
+
+    template <typename SampleType>
+    KernelFunction<SampleType> selectKernel (SaturationKernel::Accuracy accuracy, SaturationKernel::InstructionSet set) noexcept
+    {
+        switch (accuracy)
+        {
+            case SaturationKernel::Accuracy::fast:      return selectKernel<FastTier, SampleType> (set);
+            case SaturationKernel::Accuracy::balanced:  return selectKernel<BalancedTier, SampleType> (set);
+            case SaturationKernel::Accuracy::accurate:
+            default:                                    return selectKernel<AccurateTier, SampleType> (set);
+        }
+    }
+}
+
+//==============================================================================
+SaturationKernel::SaturationKernel() noexcept
+    : SaturationKernel (detectInstructionSet())
+{
+}
+
+SaturationKernel::SaturationKernel (InstructionSet instructionSetToUse) noexcept
+    : instructionSet (isAvailable (instructionSetToUse) ? instructionSetToUse : InstructionSet::scalar)
+{
+    updateFunction();
+}
+
+void SaturationKernel::setAccuracy (Accuracy newAccuracy) noexcept
+{
+    if (accuracy != newAccuracy)
+    {
+        accuracy = newAccuracy;
+        updateFunction();
+    }
+}
+
+void SaturationKernel::updateFunction() noexcept
+{
+    function = selectKernel<float> (accuracy, instructionSet);
+    doubleFunction = selectKernel<double> (accuracy, instructionSet);
+}
+
+float SaturationKernel::processSample (float x, Accuracy accuracyToUse) noexcept
+{
+    switch (accuracyToUse)
+    {
+        case Accuracy::fast:      return saturateSample<FastTier> (x);
+        case Accuracy::balanced:  return saturateSample<BalancedTier> (x);
+        case Accuracy::accurate:
+        default:                  return saturateSample<AccurateTier> (x);
+    }
+}
+
+//==============================================================================
+SaturationKernel::InstructionSet SaturationKernel::detectInstructionSet() noexcept
+{
+    for (auto candidate : { InstructionSet::avx512, InstructionSet::avx2, InstructionSet::sse2, InstructionSet::neon })
+        if (isAvailable (candidate))
+            return candidate;
+
+    return InstructionSet::scalar;
+}
+
+bool SaturationKernel::isAvailable (InstructionSet set) noexcept
+{
+    switch (set)
+    {
+       #if OVERDRIVE_SATURATION_X86
+        case InstructionSet::sse2:    return juce::SystemStats::hasSSE2();
+        case InstructionSet::avx2:    return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+        case InstructionSet::avx512:  return juce::SystemStats::hasAVX512F();
+       #endif
+       #if OVERDRIVE_SATURATION_NEON
+        case InstructionSet::neon:    return true; // Part of the AArch64 baseline
+       #endif
+        case InstructionSet::scalar:  return true;
+        default:                      return false;
+    }
+}
+
+const char* SaturationKernel::getInstructionSetName (InstructionSet set) noexcept
+{
+    switch (set)
+    {
+        case InstructionSet::sse2:    return "SSE2";
+        case InstructionSet::avx2:    return "AVX2";
+        case InstructionSet::avx512:  return "AVX-512";
+        case InstructionSet::neon:    return "NEON";
+        case InstructionSet::scalar:
+        default:                      return "Scalar";
+    }
+}
+
+float SaturationKernel::getMaximumError (Accuracy accuracyToCheck) noexcept
+{
+    switch (accuracyToCheck)
+    {
+        case Accuracy::fast:      return 2.4e-2f;
+        case Accuracy::balanced:  return 9.7e-5f;
+        case Accuracy::accurate:
+        default:                  return 4.5e-7f;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    SaturationKernel.h
+    Created: 17 Oct 2026 10:02:51am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*  Vectorised replacement for std::tanh (drive * x) * gain.
+
+    tanh is approximated by an odd rational function x * P(x^2) / Q(x^2) with the
+    input clamped to the range where the approximation has already reached +/-1.
+    Maximum absolute error against std::tanh over the whole float range:
+
+        fast      [3/2] Lambert form, clamp at 3       2.4e-2
+        balanced  [7/6] Pade approximant, clamp at 5   9.7e-5
+        accurate  [13/6] minimax fit, clamp at 7.905   4.5e-7  (a few ulp)
+
+    The accurate bound has some headroom over a check of every float input:
+    the worst case is 4.1e-7 without FMA (scalar, SSE2), where each step of
+    the polynomials is rounded separately, and 2.9e-7 with it.
+
+    The widest instruction set the CPU supports is picked at runtime:
+    SSE2 and NEON process 4 samples per instruction, AVX2/FMA 8 and AVX-512 16
+    (half as many in double precision, which uses the same curves).
+*/
+class SaturationKernel
+{
+public:
+    enum class Accuracy
+    {
+        fast,
+        balanced,
+        accurate
+    };
+
+    enum class InstructionSet
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512,
+        neon
+    };
+
+    /** Uses the widest instruction set available on this machine. */
+    SaturationKernel() noexcept;
+
+    /** Forces a particular instruction set, falling back to scalar if it isn't
+        available on this CPU or wasn't compiled into this build.
+    */
+    explicit SaturationKernel (InstructionSet instructionSetToUse) noexcept;
+
+    void setAccuracy (Accuracy newAccuracy) noexcept;
+    Accuracy getAccuracy() const noexcept                { return accuracy; }
+    InstructionSet getInstructionSet() const noexcept    { return instructionSet; }
+
+    /** output[i] = tanh (drive * input[i]) * gain. input and output may be the same buffer. */
+    void process (const float* input, float* output, int numSamples, float drive, float gain) const noexcept
+    {
+        function (input, output, numSamples, drive, gain);
+    }
+
+    void process (const double* input, double* output, int numSamples, double drive, double gain) const noexcept
+    {
+        doubleFunction (input, output, numSamples, drive, gain);
+    }
+
+    /** Scalar version of the same curve, for code that works one sample at a time. */
+    static float processSample (float x, Accuracy accuracyToUse) noexcept;
+
+    static InstructionSet detectInstructionSet() noexcept;
+    static bool isAvailable (InstructionSet) noexcept;
+    static const char* getInstructionSetName (InstructionSet) noexcept;
+    static float getMaximumError (Accuracy) noexcept;
+
+private:
+    template <typename SampleType>
+    using ProcessFunction = void (*) (const SampleType*, SampleType*, int, SampleType, SampleType) noexcept;
+
+    void updateFunction() noexcept;
+
+    InstructionSet instructionSet;
+    Accuracy accuracy = Accuracy::accurate;
+    ProcessFunction<float> function = nullptr;
+    ProcessFunction<double> doubleFunction = nullptr;
+};
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    SharedResources.cpp
+    Created: 18 Oct 2026 12:22:51am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "SharedResources.h"
+
+template <typename Key, typename Resource, typename Create>
+std::shared_ptr<const Resource> SharedResources::findOrCreate (std::map<Key, std::weak_ptr<const Resource>>& cache, Key key, Create&& create)
+{
+    const juce::ScopedLock sl (lock);
+
+    // Forget anything no instance uses any more
+    for (auto it = cache.begin(); it != cache.end();)
+        it = it->second.expired() ? cache.erase (it) : std::next (it);
+
+    if (auto found = cache.find (key); found != cache.end())
+        if (auto resource = found->second.lock())
+            return resource;
+
+    std::shared_ptr<const Resource> resource = create();
+    cache[key] = resource;
+    return resource;
+}
+
+std::shared_ptr<const CutoffTable> SharedResources::getCutoffTable (double sampleRate)
+{
+    return findOrCreate (cutoffTables, sampleRate, [sampleRate]
+    {
+        auto table = std::make_shared<CutoffTable>();
+        table->prepare (sampleRate);
+        return table;
+    });
+}
+
+std::shared_ptr<const DiodeClipperTable> SharedResources::getDiodeClipperTable (double sampleRate)
+{
+    return findOrCreate (diodeClipperTables, sampleRate, [sampleRate]
+    {
+        auto table = std::make_shared<DiodeClipperTable>();
+        table->prepare (sampleRate);
+        return table;
+    });
+}
+
+size_t SharedResources::getMemoryUsage() const
+{
+    const juce::ScopedLock sl (lock);
+    auto bytes = sizeof (*this);
+
+    for (const auto& entry : cutoffTables)
+        if (auto table = entry.second.lock())
+            bytes += table->getMemoryUsage();
+
+    for (const auto& entry : diodeClipperTables)
+        if (auto table = entry.second.lock())
+            bytes += table->getMemoryUsage();
+
+    return bytes;
+}
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    SharedResources.h
+    Created: 18 Oct 2026 12:22:51am
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "FilterSlopes.h"
+#include "DiodeClipper.h"
+
+/*  Read-only data every instance in the process can use, built once and
+    shared by reference rather than rebuilt by each instance.
+
+    Instances reach the registry through juce::SharedResourcePointer, so it
+    exists while at least one instance does. Each resource is handed out as a
+    shared_ptr to const and built on the first request for its key (the cutoff
+    and diode clipper tables, per sample rate). The registry only keeps a weak
+    reference, so a table goes away with the last instance using it: a
+    session that moves from 48k to 96k doesn't keep the 48k tables.
+
+    Lookups take a lock and may build, so they belong in prepareToPlay or on
+    the message thread. The audio thread only ever uses what it was handed.
+
+    The rest of what is shared lives elsewhere: the waveshaper tables are
+    constexpr, and the preset bank, the spectrum analyzer's FFT and the
+    editor's LookAndFeel (with its knob cache) belong to the plugin rather
+    than the core, so each has its own SharedResourcePointer. The logo comes
+    from juce::ImageCache, so open editors share one decoded copy.
+*/
+
+/** Memory use as seen from one instance. */
+struct MemoryReport
+{
+    size_t instanceBytes = 0;   // Owned by this instance alone: state, scratch buffers, FIFOs
+    size_t sharedBytes = 0;     // Tables and presets shared by every instance in the process
+    int numInstances = 0;       // How many instances share them
+};
+
+//==============================================================================
+class SharedResources
+{
+public:
+    /** The cutoff table for this sample rate, built if no instance has it yet. */
+    std::shared_ptr<const CutoffTable> getCutoffTable (double sampleRate);
+
+    /** The diode clipper's table for this sample rate (oversampled rates included), built if no instance has it yet. */
+    std::shared_ptr<const DiodeClipperTable> getDiodeClipperTable (double sampleRate);
+
+    /** Bytes held by the resources that are currently alive. */
+    size_t getMemoryUsage() const;
+
+private:
+    template <typename Key, typename Resource, typename Create>
+    std::shared_ptr<const Resource> findOrCreate (std::map<Key, std::weak_ptr<const Resource>>& cache, Key key, Create&& create);
+
+    mutable juce::CriticalSection lock;
+    std::map<double, std::weak_ptr<const CutoffTable>> cutoffTables;
+    std::map<double, std::weak_ptr<const DiodeClipperTable>> diodeClipperTables;
+};
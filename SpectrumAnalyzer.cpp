@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 17 Oct 2026 9:02:44pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+namespace
+{
+    // How fast the display falls back after a peak
+    constexpr double releaseDecibelsPerSecond = 60.0;
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : juce::Thread ("Spectrum Analyzer"),
+      samples ((size_t) fifoCapacity, 0.0f),
+      history ((size_t) fftSize, 0.0f),
+      fftData ((size_t) fftSize * 2, 0.0f)
+{
+    smoothed.fill (minimumDecibels);
+    latest.fill (minimumDecibels);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stop();
+}
+
+void SpectrumAnalyzer::prepare (double newSampleRate) noexcept
+{
+    if (newSampleRate > 0.0)
+        sampleRate = newSampleRate;
+}
+
+void SpectrumAnalyzer::start()
+{
+    if (isThreadRunning())
+        return;
+
+    std::fill (history.begin(), history.end(), 0.0f);
+    smoothed.fill (minimumDecibels);
+    tables = sharedTables->get();
+
+    startThread();
+    active = true;
+}
+
+void SpectrumAnalyzer::stop()
+{
+    // The audio thread stops pushing first; anything it pushes after this is thrown away when the thread next starts
+    active = false;
+    stopThread (1000);
+    tables.reset();
+}
+
+bool SpectrumAnalyzer::getLatestSpectrum (Spectrum& destination)
+{
+    const juce::SpinLock::ScopedLockType lock (resultLock);
+
+    if (! latestIsNew)
+        return false;
+
+    destination = latest;
+    latestIsNew = false;
+    return true;
+}
+
+float SpectrumAnalyzer::getDisplayFrequency (int index) noexcept
+{
+    return minimumFrequency * std::pow (maximumFrequency / minimumFrequency, (float) index / (float) (numDisplayPoints - 1));
+}
+
+size_t SpectrumAnalyzer::getMemoryUsage() const noexcept
+{
+    return (samples.capacity() + history.capacity() + fftData.capacity()) * sizeof (float);
+}
+
+size_t SpectrumAnalyzer::getSharedMemoryUsage() const
+{
+    return sharedTables->getMemoryUsage();
+}
+
+//==============================================================================
+SpectrumAnalyzer::Tables::Tables()
+    : fft (fftOrder),
+      window ((size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false)
+{
+}
+
+size_t SpectrumAnalyzer::Tables::getMemoryUsage() const noexcept
+{
+    // The FFT's twiddles and the window table; the FFT engine's own bookkeeping isn't visible from here
+    return sizeof (*this) + (size_t) fftSize * sizeof (juce::dsp::Complex<float>) + (size_t) (fftSize + 1) * sizeof (float);
+}
+
+std::shared_ptr<const SpectrumAnalyzer::Tables> SpectrumAnalyzer::SharedTables::get()
+{
+    const juce::ScopedLock sl (lock);
+
+    auto shared = tables.lock();
+
+    if (shared == nullptr)
+    {
+        shared = std::make_shared<const Tables>();
+        tables = shared;
+    }
+
+    return shared;
+}
+
+size_t SpectrumAnalyzer::SharedTables::getMemoryUsage() const
+{
+    const juce::ScopedLock sl (lock);
+
+    if (auto shared = tables.lock())
+        return shared->getMemoryUsage();
+
+    return 0;
+}
+
+void SpectrumAnalyzer::run()
+{
+    // Drop whatever was left over from the last time the analyzer was open
+    fifo.read (fifo.getNumReady());
+
+    while (! threadShouldExit())
+    {
+        auto numReady = fifo.getNumReady();
+
+        if (numReady < hopSize)
+        {
+            wait (10);
+            continue;
+        }
+
+        // If the thread fell behind, only the most recent frame is worth analysing
+        if (numReady > fftSize)
+        {
+            fifo.read (numReady - fftSize);
+            numReady = fftSize;
+        }
+
+        const auto numNew = numReady - numReady % hopSize;
+        std::copy (history.begin() + numNew, history.end(), history.begin());
+
+        {
+            const auto scope = fifo.read (numNew);
+            auto* destination = history.data() + fftSize - numNew;
+
+            destination = std::copy_n (samples.data() + scope.startIndex1, scope.blockSize1, destination);
+            std::copy_n (samples.data() + scope.startIndex2, scope.blockSize2, destination);
+        }
+
+        analyse();
+    }
+}
+
+void SpectrumAnalyzer::analyse()
+{
+    std::copy (history.begin(), history.end(), fftData.begin());
+    tables->window.multiplyWithWindowingTable (fftData.data(), (size_t) fftSize);
+    tables->fft.performFrequencyOnlyForwardTransform (fftData.data(), true);
+
+    const auto rate = sampleRate.load();
+    const auto binsPerHz = (float) (fftSize / rate);
+    const auto numBins = fftSize / 2;
+
+    // A full-scale sine reads 0 dB: the Hann window halves the peak bin's fftSize / 2
+    const auto normalisation = 4.0f / (float) fftSize;
+
+    // Each display point covers the band halfway to its neighbours on the log scale
+    const auto halfStep = std::pow (maximumFrequency / minimumFrequency, 0.5f / (float) (numDisplayPoints - 1));
+    const auto release = (float) (releaseDecibelsPerSecond * hopSize / rate);
+
+    for (int point = 0; point < numDisplayPoints; ++point)
+    {
+        const auto frequency = getDisplayFrequency (point);
+        const auto lowBin  = (int) std::ceil (frequency / halfStep * binsPerHz);
+        const auto highBin = juce::jmin (numBins, (int) std::floor (frequency * halfStep * binsPerHz));
+        auto magnitude = 0.0f;
+
+        if (lowBin > numBins)
+        {
+            // Above Nyquist
+        }
+        else if (highBin > lowBin)
+        {
+            // Several bins to one point at the top end: keep the loudest so narrow peaks still show
+            for (int bin = lowBin; bin <= highBin; ++bin)
+                magnitude = juce::jmax (magnitude, fftData[(size_t) bin]);
+        }
+        else
+        {
+            // Fewer than one bin per point at the bottom end: interpolate between the nearest two
+            const auto position = juce::jmin ((float) numBins - 1.0f, frequency * binsPerHz);
+            const auto bin = (int) position;
+            magnitude = juce::jmap (position - (float) bin, fftData[(size_t) bin], fftData[(size_t) bin + 1]);
+        }
+
+        const auto level = juce::Decibels::gainToDecibels (magnitude * normalisation, minimumDecibels);
+        smoothed[(size_t) point] = juce::jmax (level, smoothed[(size_t) point] - release);
+    }
+
+    const juce::SpinLock::ScopedLockType lock (resultLock);
+    latest = smoothed;
+    latestIsNew = true;
+}
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 17 Oct 2026 9:02:44pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/** Spectrum of the plugin's output for the editor.
+
+    The audio thread only mixes each block down to mono and pushes it into a
+    wait-free FIFO. Everything else (windowing, the FFT, reducing the bins to
+    log-spaced display points and the peak-hold smoothing) runs on a background
+    thread that only exists while an analyzer view is open. While it is closed
+    the audio thread checks one flag per block and does nothing else.
+
+    The FFT and window are shared with every other instance through a
+    SharedResourcePointer of their own (the core's SharedResources is kept to
+    what the DSP needs), and only held while an analyzer runs.
+*/
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr int numDisplayPoints = 256;
+    static constexpr float minimumFrequency = 20.0f;
+    static constexpr float maximumFrequency = 20000.0f;
+    static constexpr float minimumDecibels = -96.0f;
+
+    /** Level in dBFS at each display frequency. */
+    using Spectrum = std::array<float, numDisplayPoints>;
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    /** Sets the rate the display frequencies are worked out at. Safe from any thread. */
+    void prepare (double sampleRate) noexcept;
+
+    /** Message thread only: starts and stops the analysis thread and the audio thread's pushing. */
+    void start();
+    void stop();
+
+    bool isActive() const noexcept      { return active.load (std::memory_order_relaxed); }
+
+    /** Audio thread only. Pushes the mono sum of the first numChannels channels;
+        whatever doesn't fit (if the analysis thread has stalled) is dropped.
+    */
+    template <typename SampleType>
+    void push (const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept
+    {
+        numChannels = juce::jmin (numChannels, buffer.getNumChannels());
+
+        if (numChannels <= 0)
+            return;
+
+        const auto scope = fifo.write (buffer.getNumSamples());
+        const auto gain = (SampleType) 1 / (SampleType) numChannels;
+
+        const auto mixDown = [&] (int destination, int numSamples, int offset)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto sum = (SampleType) 0;
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    sum += buffer.getReadPointer (channel)[offset + i];
+
+                samples[(size_t) (destination + i)] = (float) (sum * gain);
+            }
+        };
+
+        mixDown (scope.startIndex1, scope.blockSize1, 0);
+        mixDown (scope.startIndex2, scope.blockSize2, scope.blockSize1);
+    }
+
+    /** Copies the most recent spectrum into destination. Returns false if there
+        has been no new one since the last call.
+    */
+    bool getLatestSpectrum (Spectrum& destination);
+
+    /** The frequency of display point index, log-spaced from minimumFrequency to maximumFrequency. */
+    static float getDisplayFrequency (int index) noexcept;
+
+    /** Bytes of the FIFO and analysis buffers. The shared FFT and window aren't counted. */
+    size_t getMemoryUsage() const noexcept;
+
+    /** Bytes of the FFT and window every instance shares, while any analyzer is running. */
+    size_t getSharedMemoryUsage() const;
+
+private:
+    // The FFT and window. Neither changes once built, so every instance's analysis thread can run the same ones.
+    struct Tables
+    {
+        Tables();
+
+        size_t getMemoryUsage() const noexcept;
+
+        juce::dsp::FFT fft;
+        juce::dsp::WindowingFunction<float> window;
+    };
+
+    // Builds the tables for the first analyzer to start and keeps a weak reference, so they go when the last one stops
+    struct SharedTables
+    {
+        std::shared_ptr<const Tables> get();
+        size_t getMemoryUsage() const;
+
+        mutable juce::CriticalSection lock;
+        std::weak_ptr<const Tables> tables;
+    };
+
+    void run() override;
+    void analyse();
+
+    // A quarter of a second at 192 kHz, so the thread can sleep between hops
+    static constexpr int fifoCapacity = 1 << 16;
+
+    juce::AbstractFifo fifo { fifoCapacity };
+    std::vector<float> samples;
+
+    std::atomic<bool> active { false };
+    std::atomic<double> sampleRate { 44100.0 };
+
+    juce::SharedResourcePointer<SharedTables> sharedTables;
+
+    // Analysis thread only. The tables are set by start() and dropped by stop(), around the thread.
+    std::shared_ptr<const Tables> tables;
+    std::vector<float> history, fftData;
+    Spectrum smoothed;
+
+    juce::SpinLock resultLock;
+    Spectrum latest;
+    bool latestIsNew = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
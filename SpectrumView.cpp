@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+    SpectrumView.cpp
+    Created: 17 Oct 2026 9:31:15pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "SpectrumView.h"
+
+namespace
+{
+    const auto spectrumColour = juce::Colour::fromRGB (0, 255, 255);
+    const auto responseColour = juce::Colours::orange;
+    const auto crossoverColour = juce::Colours::white;
+}
+
+SpectrumView::SpectrumView (OverDrive4AudioProcessor& p)
+    : processor (p), analyzer (p.getSpectrumAnalyzer())
+{
+    for (int i = 0; i < maxBands - 1; ++i)
+        crossoverParameters[i] = p.parameters.getParameter ("XOVER_" + juce::String (i + 1));
+
+    spectrum.fill (SpectrumAnalyzer::minimumDecibels);
+    updateFilterResponse();
+
+    analyzer.start();
+    startTimerHz (refreshRateHz);
+}
+
+SpectrumView::~SpectrumView()
+{
+    stopTimer();
+    analyzer.stop();
+}
+
+void SpectrumView::timerCallback()
+{
+    auto changed = analyzer.getLatestSpectrum (spectrum);
+
+    const auto settings = processor.readSettings();
+    const auto sampleRate = processor.getSampleRate() > 0.0 ? processor.getSampleRate() : 44100.0;
+
+    if (settings.highPassHz != filterSettings.highPassHz || settings.lowPassHz != filterSettings.lowPassHz
+         || settings.highPassSections != filterSettings.highPassSections || settings.lowPassSections != filterSettings.lowPassSections
+         || settings.filterAlignment != filterSettings.filterAlignment || sampleRate != responseSampleRate)
+    {
+        updateFilterResponse();
+        changed = true;
+    }
+
+    // The crossovers don't change the filters' response, only where their lines go
+    if (settings.multiband.numBands != filterSettings.multiband.numBands
+         || settings.multiband.crossoverHz != filterSettings.multiband.crossoverHz)
+    {
+        filterSettings.multiband = settings.multiband;
+        changed = true;
+    }
+
+    if (changed)
+        repaint();
+}
+
+void SpectrumView::updateFilterResponse()
+{
+    filterSettings = processor.readSettings();
+    responseSampleRate = processor.getSampleRate() > 0.0 ? processor.getSampleRate() : 44100.0;
+
+    for (int point = 0; point < SpectrumAnalyzer::numDisplayPoints; ++point)
+    {
+        const auto magnitude = OverDriveDSP<float>::getFilterResponse (filterSettings, responseSampleRate, SpectrumAnalyzer::getDisplayFrequency (point));
+        filterResponse[(size_t) point] = juce::Decibels::gainToDecibels ((float) magnitude, SpectrumAnalyzer::minimumDecibels);
+    }
+}
+
+float SpectrumView::frequencyToX (float frequency, juce::Rectangle<float> area) const noexcept
+{
+    const auto proportion = std::log (frequency / SpectrumAnalyzer::minimumFrequency)
+                          / std::log (SpectrumAnalyzer::maximumFrequency / SpectrumAnalyzer::minimumFrequency);
+    return area.getX() + area.getWidth() * proportion;
+}
+
+float SpectrumView::decibelsToY (float decibels, juce::Rectangle<float> area) const noexcept
+{
+    return juce::jmap (juce::jlimit (SpectrumAnalyzer::minimumDecibels, maximumDecibels, decibels),
+                       SpectrumAnalyzer::minimumDecibels, maximumDecibels, area.getBottom(), area.getY());
+}
+
+float SpectrumView::xToFrequency (float x, juce::Rectangle<float> area) const noexcept
+{
+    const auto proportion = juce::jlimit (0.0f, 1.0f, (x - area.getX()) / area.getWidth());
+    return SpectrumAnalyzer::minimumFrequency
+         * std::pow (SpectrumAnalyzer::maximumFrequency / SpectrumAnalyzer::minimumFrequency, proportion);
+}
+
+int SpectrumView::getCrossoverAt (float x) const noexcept
+{
+    const auto area = getPlotArea();
+    auto nearest = -1;
+    auto nearestDistance = crossoverGrabDistance;
+
+    for (int i = 0; i < filterSettings.multiband.numBands - 1; ++i)
+    {
+        const auto distance = std::abs (frequencyToX (filterSettings.multiband.crossoverHz[(size_t) i], area) - x);
+
+        if (distance <= nearestDistance)
+        {
+            nearest = i;
+            nearestDistance = distance;
+        }
+    }
+
+    return nearest;
+}
+
+void SpectrumView::mouseMove (const juce::MouseEvent& e)
+{
+    setMouseCursor (getCrossoverAt (e.position.x) >= 0 ? juce::MouseCursor::LeftRightResizeCursor
+                                                        : juce::MouseCursor::NormalCursor);
+}
+
+void SpectrumView::mouseDown (const juce::MouseEvent& e)
+{
+    draggedCrossover = getCrossoverAt (e.position.x);
+
+    if (draggedCrossover >= 0)
+        crossoverParameters[draggedCrossover]->beginChangeGesture();
+}
+
+void SpectrumView::mouseDrag (const juce::MouseEvent& e)
+{
+    if (draggedCrossover < 0)
+        return;
+
+    auto* parameter = crossoverParameters[draggedCrossover];
+    const auto frequency = parameter->getNormalisableRange().snapToLegalValue (xToFrequency (e.position.x, getPlotArea()));
+    parameter->setValueNotifyingHost (parameter->convertTo0to1 (frequency));
+}
+
+void SpectrumView::mouseUp (const juce::MouseEvent&)
+{
+    if (draggedCrossover >= 0)
+        crossoverParameters[draggedCrossover]->endChangeGesture();
+
+    draggedCrossover = -1;
+}
+
+void SpectrumView::paint (juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour (juce::Colours::black.withAlpha (0.25f));
+    g.fillRoundedRectangle (bounds, 6.0f);
+    g.setColour (juce::Colours::grey);
+    g.drawRoundedRectangle (bounds, 6.0f, 1.0f);
+
+    const auto area = getPlotArea();
+
+    // Decades and every 24 dB
+    g.setFont (11.0f);
+
+    for (auto frequency : { 100.0f, 1000.0f, 10000.0f })
+    {
+        const auto x = frequencyToX (frequency, area);
+        g.setColour (juce::Colours::grey.withAlpha (0.4f));
+        g.drawVerticalLine (juce::roundToInt (x), area.getY(), area.getBottom());
+        g.setColour (juce::Colours::grey);
+        g.drawText (frequency < 1000.0f ? "100" : juce::String (juce::roundToInt (frequency / 1000.0f)) + "k",
+                    juce::Rectangle<float> (x + 2.0f, area.getBottom() - 12.0f, 30.0f, 12.0f), juce::Justification::centredLeft);
+    }
+
+    for (auto decibels = 0.0f; decibels > SpectrumAnalyzer::minimumDecibels; decibels -= 24.0f)
+    {
+        const auto y = decibelsToY (decibels, area);
+        g.setColour (juce::Colours::grey.withAlpha (0.4f));
+        g.drawHorizontalLine (juce::roundToInt (y), area.getX(), area.getRight());
+        g.setColour (juce::Colours::grey);
+        g.drawText (juce::String (juce::roundToInt (decibels)) + " dB",
+                    juce::Rectangle<float> (area.getX() + 2.0f, y - 12.0f, 40.0f, 12.0f), juce::Justification::centredLeft);
+    }
+
+    // Spectrum, filled down to the floor
+    juce::Path spectrumPath, responsePath;
+    spectrumPath.startNewSubPath (area.getX(), area.getBottom());
+
+    for (int point = 0; point < SpectrumAnalyzer::numDisplayPoints; ++point)
+    {
+        const auto x = frequencyToX (SpectrumAnalyzer::getDisplayFrequency (point), area);
+        spectrumPath.lineTo (x, decibelsToY (spectrum[(size_t) point], area));
+
+        if (point == 0)
+            responsePath.startNewSubPath (x, decibelsToY (filterResponse[0], area));
+        else
+            responsePath.lineTo (x, decibelsToY (filterResponse[(size_t) point], area));
+    }
+
+    spectrumPath.lineTo (area.getRight(), area.getBottom());
+    spectrumPath.closeSubPath();
+
+    g.setColour (spectrumColour.withAlpha (0.25f));
+    g.fillPath (spectrumPath);
+    g.setColour (spectrumColour.withAlpha (0.8f));
+    g.strokePath (spectrumPath, juce::PathStrokeType (1.0f));
+
+    // The filters' response, 0 dB where they pass
+    g.setColour (responseColour);
+    g.strokePath (responsePath, juce::PathStrokeType (1.5f));
+
+    // Crossovers, labelled with their frequency
+    for (int i = 0; i < filterSettings.multiband.numBands - 1; ++i)
+    {
+        const auto frequency = filterSettings.multiband.crossoverHz[(size_t) i];
+        const auto x = frequencyToX (frequency, area);
+        const auto label = frequency < 1000.0f ? juce::String (juce::roundToInt (frequency))
+                                               : juce::String (frequency / 1000.0f, 1) + "k";
+
+        g.setColour (crossoverColour.withAlpha (i == draggedCrossover ? 1.0f : 0.6f));
+        g.drawVerticalLine (juce::roundToInt (x), area.getY(), area.getBottom());
+        g.drawText (label, juce::Rectangle<float> (x + 3.0f, area.getY(), 40.0f, 12.0f), juce::Justification::centredLeft);
+    }
+}
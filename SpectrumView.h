@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    SpectrumView.h
+    Created: 17 Oct 2026 9:31:15pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+/** The output spectrum with the magnitude response of the HPF and LPF drawn
+    over it. The analysis runs on the analyzer's own thread; this only picks up
+    finished spectra on a timer. The analyzer runs for as long as the view exists.
+
+    In multiband mode the crossovers are drawn as lines that can be dragged.
+*/
+class SpectrumView : public juce::Component,
+                     private juce::Timer
+{
+public:
+    explicit SpectrumView (OverDrive4AudioProcessor&);
+    ~SpectrumView() override;
+
+    void paint (juce::Graphics&) override;
+
+    void mouseMove (const juce::MouseEvent&) override;
+    void mouseDown (const juce::MouseEvent&) override;
+    void mouseDrag (const juce::MouseEvent&) override;
+    void mouseUp (const juce::MouseEvent&) override;
+
+private:
+    void timerCallback() override;
+    void updateFilterResponse();
+
+    float frequencyToX (float frequency, juce::Rectangle<float> area) const noexcept;
+    float decibelsToY (float decibels, juce::Rectangle<float> area) const noexcept;
+    float xToFrequency (float x, juce::Rectangle<float> area) const noexcept;
+
+    juce::Rectangle<float> getPlotArea() const noexcept      { return getLocalBounds().toFloat().reduced (6.0f); }
+    int getCrossoverAt (float x) const noexcept;
+
+    OverDrive4AudioProcessor& processor;
+    SpectrumAnalyzer& analyzer;
+
+    SpectrumAnalyzer::Spectrum spectrum;
+    SpectrumAnalyzer::Spectrum filterResponse;     // dB, at the same frequencies
+
+    // The response is only worked out again when a cutoff, slope or the sample rate changes
+    OverDriveSettings filterSettings;
+    double responseSampleRate = 0.0;
+
+    juce::RangedAudioParameter* crossoverParameters[maxBands - 1];
+    int draggedCrossover = -1;
+
+    static constexpr int refreshRateHz = 30;
+    static constexpr float maximumDecibels = 12.0f;
+    static constexpr float crossoverGrabDistance = 6.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumView)
+};
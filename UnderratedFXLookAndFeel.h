@@ -11,6 +11,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <map>
 
 class UnderratedFXLookAndFeel : public juce::LookAndFeel_V4
 {
@@ -37,19 +38,47 @@ public:
         auto radius = (float) juce::jmin(width / 2, height / 2) - 4.0f;
         auto centreX = (float) x + (float) width * 0.5f;
         auto centreY = (float) y + (float) height * 0.5f;
+        auto angle = rotaryStartAngle + sliderPosProportional * (rotaryEndAngle - rotaryStartAngle);
+
+        // The knob body never changes, so it comes from the cache; only the pointer is drawn each time
+        const auto& body = getKnobBody(g, width, height,
+                                       slider.findColour(juce::Slider::rotarySliderFillColourId),
+                                       slider.findColour(juce::Slider::rotarySliderOutlineColourId));
+        g.drawImage(body, juce::Rectangle<int>(x, y, width, height).toFloat());
+
+        juce::Path p;
+        auto pointerLength = radius; // Pointer length to reach the edge
+        auto pointerThickness = 4.0f; // Thicker pointer
+        p.addRectangle(-pointerThickness * 0.5f, -radius, pointerThickness, pointerLength);
+        p.applyTransform(juce::AffineTransform::rotation(angle).translated(centreX, centreY));
+
+        // Draw pointer with shadow
+        g.setColour(shadowColour.withAlpha(0.5f)); // Use global shadow color
+        g.fillPath(p, juce::AffineTransform::translation(2.0f, 2.0f)); // Draw shadow
+
+        // Draw pointer
+        g.setColour(pointerColour); // Use global pointer color
+        g.fillPath(p);
+    }
+
+    // Renders the knob body (shadow, gradient fill, outlines) at the origin
+    static void drawKnobBody(juce::Graphics& g, int width, int height, juce::Colour fillColour, juce::Colour outlineColour)
+    {
+        auto radius = (float) juce::jmin(width / 2, height / 2) - 4.0f;
+        auto centreX = (float) width * 0.5f;
+        auto centreY = (float) height * 0.5f;
         auto rx = centreX - radius;
         auto ry = centreY - radius;
         auto rw = radius * 2.0f;
-        auto angle = rotaryStartAngle + sliderPosProportional * (rotaryEndAngle - rotaryStartAngle);
 
         // Draw 3D shadow for base circle
         g.setColour(shadowColour.withAlpha(0.3f));
         g.fillEllipse(rx + 2.0f, ry + 2.0f, rw, rw);
 
         // Fill base circle with gradient for 3D effect
-        juce::ColourGradient gradient(slider.findColour(juce::Slider::rotarySliderFillColourId).brighter(0.1f),
+        juce::ColourGradient gradient(fillColour.brighter(0.1f),
                                       centreX, centreY - radius,
-                                      slider.findColour(juce::Slider::rotarySliderFillColourId).darker(0.1f),
+                                      fillColour.darker(0.1f),
                                       centreX, centreY + radius,
                                       false);
         g.setGradientFill(gradient);
@@ -59,26 +88,34 @@ public:
         g.setColour(shadowColour.withAlpha(0.5f)); // Use global shadow color
         g.drawEllipse(rx - 2, ry - 2, rw + 4, rw + 4, 2.0f); // Draw shadow
 
-        g.setColour(slider.findColour(juce::Slider::rotarySliderOutlineColourId));
+        g.setColour(outlineColour);
         g.drawEllipse(rx, ry, rw, rw, 1.5f);
 
         // Add highlights for a more 3D look
         g.setColour(juce::Colours::black.withAlpha(0.35f));
         g.drawEllipse(rx + 1, ry + 1, rw - 2, rw - 2, 2.0f);
+    }
 
-        juce::Path p;
-        auto pointerLength = radius; // Pointer length to reach the edge
-        auto pointerThickness = 4.0f; // Thicker pointer
-        p.addRectangle(-pointerThickness * 0.5f, -radius, pointerThickness, pointerLength);
-        p.applyTransform(juce::AffineTransform::rotation(angle).translated(centreX, centreY));
+    // One cached body per knob size, display scale and colour scheme. The LookAndFeel
+    // is shared by every open editor, so they all reuse the same images.
+    const juce::Image& getKnobBody(juce::Graphics& g, int width, int height, juce::Colour fillColour, juce::Colour outlineColour)
+    {
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        const auto key = std::make_tuple(width, height, juce::roundToInt(scale * 100.0f), fillColour.getARGB(), outlineColour.getARGB());
 
-        // Draw pointer with shadow
-        g.setColour(shadowColour.withAlpha(0.5f)); // Use global shadow color
-        g.fillPath(p, juce::AffineTransform::translation(2.0f, 2.0f)); // Draw shadow
+        if (auto found = knobBodies.find(key); found != knobBodies.end())
+            return found->second;
 
-        // Draw pointer
-        g.setColour(pointerColour); // Use global pointer color
-        g.fillPath(p);
+        // Knob sizes are fixed per editor, so this only grows if the scale keeps changing
+        if (knobBodies.size() >= 32)
+            knobBodies.clear();
+
+        juce::Image image(juce::Image::ARGB, juce::jmax(1, juce::roundToInt(width * scale)), juce::jmax(1, juce::roundToInt(height * scale)), true);
+        juce::Graphics imageGraphics(image);
+        imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+        drawKnobBody(imageGraphics, width, height, fillColour, outlineColour);
+
+        return knobBodies.emplace(key, image).first->second;
     }
 
     void drawInnerShadow(juce::Graphics& g, juce::Rectangle<float> bounds, float cornerSize, float shadowSize)
@@ -108,11 +145,10 @@ public:
         g.drawRoundedRectangle(innerBounds, cornerSize, 1.0f);
     }
 
-    static juce::Colour shadowColour;
-    static juce::Colour pointerColour;
-};
-
-// Define the static member variables
-juce::Colour UnderratedFXLookAndFeel::shadowColour = juce::Colour::fromRGB(90, 90, 90);
-juce::Colour UnderratedFXLookAndFeel::pointerColour = juce::Colour::fromRGB(85, 85, 85);
+    // Inline, so every file that includes this header shares one definition
+    inline static const juce::Colour shadowColour = juce::Colour::fromRGB(90, 90, 90);
+    inline static const juce::Colour pointerColour = juce::Colour::fromRGB(85, 85, 85);
 
+private:
+    std::map<std::tuple<int, int, int, juce::uint32, juce::uint32>, juce::Image> knobBodies;
+};
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    WaveshaperCurves.cpp
+    Created: 17 Oct 2026 6:48:02pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#include "WaveshaperCurves.h"
+
+juce::String UserCurve::toString() const
+{
+    juce::StringArray values;
+
+    for (auto point : points)
+        values.add (juce::String (point, 4));
+
+    return values.joinIntoString (",");
+}
+
+UserCurve UserCurve::fromString (const juce::String& text)
+{
+    UserCurve curve;
+    const auto values = juce::StringArray::fromTokens (text, ",", {});
+
+    // Anything malformed leaves the default straight line
+    if (values.size() != numPoints)
+        return curve;
+
+    for (int i = 0; i < numPoints; ++i)
+        curve.points[(size_t) i] = juce::jlimit (-1.0f, 1.0f, values[i].getFloatValue());
+
+    curve.points[numPoints / 2] = 0.0f;
+    return curve;
+}
+
+float evaluateWaveshaperCurve (WaveshaperCurve curve, float x, const UserCurve* userCurve) noexcept
+{
+    switch (curve)
+    {
+        case WaveshaperCurve::tube:        return WaveshaperShapes::Tube() (x);
+        case WaveshaperCurve::softClip:    return WaveshaperShapes::SoftClip() (x);
+        case WaveshaperCurve::hardClip:    return WaveshaperShapes::HardClip() (x);
+        case WaveshaperCurve::foldback:    return WaveshaperShapes::Foldback() (x);
+        case WaveshaperCurve::user:        return WaveshaperShapes::User { userCurve } (x);
+        case WaveshaperCurve::tanh:
+        default:                           return SaturationKernel::processSample (x, SaturationKernel::Accuracy::accurate);
+    }
+}
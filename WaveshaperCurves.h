@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+    WaveshaperCurves.h
+    Created: 17 Oct 2026 6:48:02pm
+    Author:  Bradley Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "SaturationKernel.h"
+
+/*  The drive curves other than tanh, which stays on the SIMD SaturationKernel.
+
+    Curves that cost more to compute than to look up (tube, foldback) are sampled
+    into tables at compile time and read back with cubic interpolation. The
+    clips are cheaper than any table, so they are computed directly. The
+    user-drawn curve is a set of points joined by straight lines.
+
+    Each curve is a small functor wrapped in Waveshaper, which has the same
+    process() signature as SaturationKernel. The DSP picks the curve once per
+    block and runs a separately compiled copy of the pipeline for it, so there
+    is no per-sample branch and the tanh path is exactly as it was.
+*/
+enum class WaveshaperCurve
+{
+    tanh,
+    tube,
+    softClip,
+    hardClip,
+    foldback,
+    user
+};
+
+namespace WaveshaperMath
+{
+    // std:: maths isn't constexpr, so the tables are generated with these
+
+    constexpr double exp (double x)
+    {
+        // Halve into the range where the series converges quickly, then square back up
+        int halvings = 0;
+
+        while (x > 0.5 || x < -0.5)
+        {
+            x *= 0.5;
+            ++halvings;
+        }
+
+        double sum = 1.0, term = 1.0;
+
+        for (int n = 1; n < 20; ++n)
+        {
+            term *= x / n;
+            sum += term;
+        }
+
+        for (; halvings > 0; --halvings)
+            sum *= sum;
+
+        return sum;
+    }
+
+    constexpr double tanh (double x)
+    {
+        if (x < 0.0)
+            return -tanh (-x);
+
+        const auto e = exp (-2.0 * x);
+        return (1.0 - e) / (1.0 + e);
+    }
+
+    constexpr double sin (double x)
+    {
+        constexpr double pi = 3.14159265358979323846;
+
+        // Into [-pi, pi)
+        const auto turns = (x + pi) / (2.0 * pi);
+        auto wholeTurns = (double) (long long) turns;
+
+        if (wholeTurns > turns)
+            wholeTurns -= 1.0;
+
+        x -= wholeTurns * 2.0 * pi;
+
+        double sum = x, term = x;
+
+        for (int n = 1; n < 16; ++n)
+        {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+
+        return sum;
+    }
+}
+
+namespace WaveshaperTables
+{
+    /** numIntervals + 1 samples of function spanning [start, end], plus one guard
+        sample before and two after so cubic interpolation never reads past the ends.
+    */
+    template <typename SampleType, int numIntervals, typename Function>
+    constexpr std::array<SampleType, numIntervals + 3> make (Function function, double start, double end)
+    {
+        std::array<SampleType, numIntervals + 3> table {};
+
+        for (int i = 0; i < numIntervals + 3; ++i)
+            table[(size_t) i] = (SampleType) function (start + (end - start) * (i - 1) / numIntervals);
+
+        return table;
+    }
+
+    /** Catmull-Rom interpolation at position (in intervals, 0 to numIntervals) of a table made by make(). */
+    template <typename SampleType, size_t tableSize>
+    inline SampleType interpolate (const std::array<SampleType, tableSize>& table, SampleType position) noexcept
+    {
+        constexpr int numIntervals = (int) tableSize - 3;
+        const auto index = juce::jlimit (0, numIntervals - 1, (int) position);
+        const auto t = position - (SampleType) index;
+        const auto* p = table.data() + index;
+
+        return p[1] + (SampleType) 0.5 * t * (p[2] - p[0]
+                    + t * ((SampleType) 2 * p[0] - (SampleType) 5 * p[1] + (SampleType) 4 * p[2] - p[3]
+                    + t * ((SampleType) 3 * (p[1] - p[2]) + p[3] - p[0])));
+    }
+
+    // Asymmetric tanh: biased so the positive half clips earlier and softer, like
+    // a single-ended triode, which adds even harmonics. Normalised to -1 at the
+    // hard side and passing through zero, so silence stays silent.
+    constexpr double tubeBias = 0.2;
+    constexpr double tubeRange = 8.0;     // Past this the curve is flat to within 1e-7
+    constexpr int tubeIntervals = 512;
+    constexpr int foldbackIntervals = 256;
+
+    constexpr double tube (double x)
+    {
+        const auto offset = WaveshaperMath::tanh (tubeBias);
+        return (WaveshaperMath::tanh (x + tubeBias) - offset) / (1.0 + offset);
+    }
+
+    // Sine foldback: one period, x from 0 to 4
+    constexpr double foldback (double x)
+    {
+        return WaveshaperMath::sin (0.5 * 3.14159265358979323846 * x);
+    }
+
+    template <typename SampleType>
+    inline constexpr auto tubeTable = make<SampleType, tubeIntervals> (tube, -tubeRange, tubeRange);
+
+    template <typename SampleType>
+    inline constexpr auto foldbackTable = make<SampleType, foldbackIntervals> (foldback, 0.0, 4.0);
+}
+
+//==============================================================================
+/** The drawn curve: output values at evenly spaced inputs from -1 to 1. Inputs
+    beyond that hold the end values. The middle point is pinned to zero.
+*/
+struct UserCurve
+{
+    static constexpr int numPoints = 33;
+    std::array<float, numPoints> points;
+
+    /** A straight line, which clips at +/-1. */
+    UserCurve() noexcept
+    {
+        for (int i = 0; i < numPoints; ++i)
+            points[(size_t) i] = (float) (2 * i - (numPoints - 1)) / (float) (numPoints - 1);
+    }
+
+    template <typename SampleType>
+    SampleType evaluate (SampleType x) const noexcept
+    {
+        constexpr auto scale = (SampleType) (numPoints - 1) / (SampleType) 2;
+        const auto position = (juce::jlimit ((SampleType) -1, (SampleType) 1, x) + (SampleType) 1) * scale;
+        const auto index = juce::jmin (numPoints - 2, (int) position);
+        const auto t = position - (SampleType) index;
+
+        return (SampleType) points[(size_t) index] + t * (SampleType) (points[(size_t) index + 1] - points[(size_t) index]);
+    }
+
+    juce::String toString() const;
+    static UserCurve fromString (const juce::String&);
+};
+
+//==============================================================================
+namespace WaveshaperShapes
+{
+    struct Tube
+    {
+        template <typename SampleType>
+        SampleType operator() (SampleType x) const noexcept
+        {
+            constexpr auto range = (SampleType) WaveshaperTables::tubeRange;
+            constexpr auto scale = (SampleType) WaveshaperTables::tubeIntervals / (2 * range);
+            return WaveshaperTables::interpolate (WaveshaperTables::tubeTable<SampleType>, (juce::jlimit (-range, range, x) + range) * scale);
+        }
+    };
+
+    struct SoftClip
+    {
+        // Cubic soft clip, reaching +/-1 with zero slope at +/-1
+        template <typename SampleType>
+        SampleType operator() (SampleType x) const noexcept
+        {
+            x = juce::jlimit ((SampleType) -1, (SampleType) 1, x);
+            return x * ((SampleType) 1.5 - (SampleType) 0.5 * x * x);
+        }
+    };
+
+    struct HardClip
+    {
+        template <typename SampleType>
+        SampleType operator() (SampleType x) const noexcept
+        {
+            return juce::jlimit ((SampleType) -1, (SampleType) 1, x);
+        }
+    };
+
+    struct Foldback
+    {
+        template <typename SampleType>
+        SampleType operator() (SampleType x) const noexcept
+        {
+            // Wrap into one period, counted in table intervals
+            constexpr auto period = (SampleType) WaveshaperTables::foldbackIntervals;
+            constexpr auto intervalsPerUnit = period / 4;
+            const auto position = x * intervalsPerUnit;
+            return WaveshaperTables::interpolate (WaveshaperTables::foldbackTable<SampleType>,
+                                                  position - period * std::floor (position / period));
+        }
+    };
+
+    struct User
+    {
+        const UserCurve* curve = nullptr;
+
+        template <typename SampleType>
+        SampleType operator() (SampleType x) const noexcept
+        {
+            return curve != nullptr ? curve->evaluate (x) : juce::jlimit ((SampleType) -1, (SampleType) 1, x);
+        }
+    };
+}
+
+/** Applies a shape with the same interface as SaturationKernel::process:
+    output[i] = shape (drive * input[i]) * gain.
+*/
+template <typename Shape>
+struct Waveshaper
+{
+    Shape shape;
+
+    template <typename SampleType>
+    void process (const SampleType* input, SampleType* output, int numSamples, SampleType drive, SampleType gain) const noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = shape (drive * input[i]) * gain;
+    }
+};
+
+/** One sample of any curve, for drawing it. Not meant for the audio path. */
+float evaluateWaveshaperCurve (WaveshaperCurve curve, float x, const UserCurve* userCurve) noexcept;